@@ -0,0 +1,119 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Memory barrier engine							*/
+
+#pragma once
+
+namespace Register {
+
+	/* Memory access ordering level, from the weakest to the strongest */
+	enum class Ordering {
+		/* No ordering at all */
+		None,
+		/* Compiler fence only, CPU may reorder */
+		Compiler,
+		/* Device accesses are observed in program order ("dmb osh") */
+		Device,
+		/* Access is complete, before any next instruction ("dsb") */
+		Complete
+	};
+
+	/* Accesses, ordered by barrier */
+	enum class BarrierType {
+		Load,
+		Store,
+		Full
+	};
+
+	inline void compilerBarrier(void) {
+		asm volatile ("" ::: "memory");
+	}
+
+	/*
+		The cheapest instruction of target architecture, for each ordering level.
+		ARMv7-A has no load-only barriers, so full barrier is used instead.
+		x86 uncached memory (MMIO) is strongly ordered, so only compiler fence is needed for device ordering.
+	*/
+	template<BarrierType type>
+	inline void deviceBarrier(void) {
+#if defined(__aarch64__)
+		if constexpr ( BarrierType::Load == type ) {
+			asm volatile ("dmb oshld" ::: "memory");
+		} else if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("dmb oshst" ::: "memory");
+		} else {
+			asm volatile ("dmb osh" ::: "memory");
+		}
+#elif defined(__arm__) && ( __ARM_ARCH >= 8 )
+		if constexpr ( BarrierType::Load == type ) {
+			asm volatile ("dmb oshld" ::: "memory");
+		} else if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("dmb oshst" ::: "memory");
+		} else {
+			asm volatile ("dmb osh" ::: "memory");
+		}
+#elif defined(__arm__)
+		if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("dmb oshst" ::: "memory");
+		} else {
+			asm volatile ("dmb osh" ::: "memory");
+		}
+#elif defined(__x86_64__) || defined(__i386__)
+		compilerBarrier();
+#else
+		__atomic_thread_fence( __ATOMIC_SEQ_CST );
+#endif
+	}
+
+	template<BarrierType type>
+	inline void completeBarrier(void) {
+#if defined(__aarch64__) || ( defined(__arm__) && ( __ARM_ARCH >= 8 ) )
+		if constexpr ( BarrierType::Load == type ) {
+			asm volatile ("dsb ld" ::: "memory");
+		} else if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("dsb st" ::: "memory");
+		} else {
+			asm volatile ("dsb sy" ::: "memory");
+		}
+#elif defined(__arm__)
+		if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("dsb st" ::: "memory");
+		} else {
+			asm volatile ("dsb sy" ::: "memory");
+		}
+#elif defined(__x86_64__) || defined(__i386__)
+		if constexpr ( BarrierType::Load == type ) {
+			asm volatile ("lfence" ::: "memory");
+		} else if constexpr ( BarrierType::Store == type ) {
+			asm volatile ("sfence" ::: "memory");
+		} else {
+			asm volatile ("mfence" ::: "memory");
+		}
+#else
+		__atomic_thread_fence( __ATOMIC_SEQ_CST );
+#endif
+	}
+
+	template<Ordering order, BarrierType type>
+	inline void barrier(void) {
+		if constexpr ( Ordering::Compiler == order ) {
+			compilerBarrier();
+		} else if constexpr ( Ordering::Device == order ) {
+			deviceBarrier<type>();
+		} else if constexpr ( Ordering::Complete == order ) {
+			completeBarrier<type>();
+		}
+	}
+
+	/* Ordering is known at run time only, it is folded when inlined with constant */
+	template<BarrierType type>
+	inline void barrier( const Ordering order ) {
+		switch ( order ) {
+			case Ordering::None:		break;
+			case Ordering::Compiler:	barrier<Ordering::Compiler, type>(); break;
+			case Ordering::Device:		barrier<Ordering::Device, type>(); break;
+			case Ordering::Complete:	barrier<Ordering::Complete, type>(); break;
+		}
+	}
+
+} // Register
@@ -3,17 +3,29 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <MemIoBarrier.h>
+#include <MemIoRmw.h>
 
 namespace Register {
 
+	/* Order of bus accesses, when register is wider then bus. Low part of register is at lower address */
+	enum class SplitOrder {
+		LowFirst,
+		HighFirst
+	};
+
 	/* Defualt memory mapped register description */
-	template<typename RegValueType = uint32_t, typename BusAccessType = uint32_t>
+	template<typename RegValueType = uint32_t, typename BusAccessType = uint32_t, Ordering readOrder = Ordering::Device, Ordering writeOrder = Ordering::Device, typename RmwPolicyArg = Rmw::None,
+			 SplitOrder readSplit = SplitOrder::LowFirst, SplitOrder writeSplit = SplitOrder::LowFirst, bool laneWrites = false>
 	struct MemIoDescription {
 		/* Bus address type */
 		using BusDataType = BusAccessType;
 
 		/* Register value type ( uint8_t, uint16_t, uint32_t, uint64_t )*/
 		using RegDataType = RegValueType;
+
+		/* Concurrency policy of read-modify-write ( see MemIoRmw.h ) */
+		using RmwPolicy = RmwPolicyArg;
 		
 		/* Access type */
 		struct Access {	
@@ -21,10 +33,14 @@ namespace Register {
 			struct Read {
 				/* Is read operation of this register allowed? */
 				static constexpr const bool readable = true;
+				/* Order of bus reads, when register is wider then bus (i.e. low part latches high one) */
+				static constexpr const SplitOrder split = readSplit;
 				/* Synchronization policy */
 				struct Sync {
 					/* CPU syncronization like memory syncronization barier */
-					static constexpr const bool cpu = true;
+					static constexpr const bool cpu = ( Ordering::None != readOrder );
+					/* The weakest sufficient ordering level of barrier before read */
+					static constexpr const Ordering order = readOrder;
 					/* Cahce syncronization, like cahce line invalidation, or read buffer sync */
 					static constexpr const bool cache = false;
 				};
@@ -33,9 +49,15 @@ namespace Register {
 			struct Write {
 				/* I write operation allowed? */
 				static constexpr const bool writable = true;
+				/* Order of bus writes, when register is wider then bus (i.e. high part commits value) */
+				static constexpr const SplitOrder split = writeSplit;
+				/* Bus has byte strobes: byte or halfword store changes only its lane of register */
+				static constexpr const bool lanes = laneWrites;
 				struct Sync {
 					/* CPU syncronization like memory synctonization barier */
-					static constexpr const bool cpu = true;
+					static constexpr const bool cpu = ( Ordering::None != writeOrder );
+					/* The weakest sufficient ordering level of barrier after write */
+					static constexpr const Ordering order = writeOrder;
 					/* Cahce syncronization like cahce write back (line close), or write buffer flush */
 					static constexpr const bool cache = false;
 				};
@@ -79,6 +101,29 @@ namespace Register {
 	using Mem32IoDescription = MemIoDescription<uint32_t, uint32_t>;
 	using Mem16IoDescription = MemIoDescription<uint16_t, uint32_t>;
 	using Mem8IoDescription  = MemIoDescription<uint8_t,  uint32_t>;
+
+	/* Register doesn't need any ordering, access is a bare load or store */
+	using Mem32IoNoSyncDescription = MemIoDescription<uint32_t, uint32_t, Ordering::None, Ordering::None>;
+
+	/* Register access must be complete, before next instruction (i.e. clock or power switch) */
+	using Mem32IoCompleteDescription = MemIoDescription<uint32_t, uint32_t, Ordering::Complete, Ordering::Complete>;
+
+	/* 64 bit register on 64 bit bus, single access */
+	using Mem64IoDescription = MemIoDescription<uint64_t, uint64_t>;
+
+	/* 64 bit register on 32 bit bus, pair of accesses in given order */
+	template<SplitOrder readSplit = SplitOrder::LowFirst, SplitOrder writeSplit = SplitOrder::LowFirst>
+	using Mem64On32IoDescription = MemIoDescription<uint64_t, uint32_t, Ordering::Device, Ordering::Device, Rmw::None, readSplit, writeSplit>;
+
+	/* Bus with byte strobes, partial write of register may be a narrow store without read */
+	using Mem32IoLaneDescription = MemIoDescription<uint32_t, uint32_t, Ordering::Device, Ordering::Device, Rmw::None, SplitOrder::LowFirst, SplitOrder::LowFirst, true>;
+
+	/* Register has read-to-clear (RC) fields, RMW is compile error */
+	using Mem32IoReadClearDescription = MemIoDescription<uint32_t, uint32_t, Ordering::Device, Ordering::Device, Rmw::Forbidden>;
+
+	/* Register is modified by several contexts, RMW is protected by policy (i.e. Rmw::StripedLock<>) */
+	template<typename RmwPolicy>
+	using Mem32IoRmwDescription = MemIoDescription<uint32_t, uint32_t, Ordering::Device, Ordering::Device, RmwPolicy>;
 		
 } // Register
 
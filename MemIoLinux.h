@@ -0,0 +1,149 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Linux userspace register access backend			*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <RegistersClass.h>
+
+namespace Register {
+namespace Linux {
+
+	/*
+		Mapped register window.
+		Register address is resolved as "mapped base + ( address - physBase )".
+		The window keeps only one value "bias = mapped base - physBase",
+		so each access is register address + bias.
+
+		Usage:
+			struct CrgWindow : public Register::Linux::Window< 0x12010000, 0x1000 > {};
+			#define PERI_CRG_IO Register::Linux::MappedIo< CrgWindow >
+			#include <hi3516ev200_pll_regs.h>
+			...
+			Register::Linux::Mapping< CrgWindow > mapping;	// "/dev/mem", or CrgWindow::open( "/dev/uio0", 0 )
+			if ( !mapping.isMapped() ) { ... }
+
+			PllConfig1::Bypass::set( PllConfig1::Bypass::Type::Bypass );	// bias is loaded by each access
+
+			const Register::Linux::MappedBlock< CrgWindow > crg;			// bias is loaded once
+			crg.Set< PllConfig1::Bypass >( PllConfig1::Bypass::Type::Bypass );
+			crg.Write< PllConfig0, PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( 0, 2, 1 );
+
+		Bias is a static of window, so barrier ("memory" clobber) makes compiler load it again before next
+		access. Sequence of accesses should use MappedBlock: base is resolved once, and each access
+		is base register + constant offset.
+
+		Regular file or memfd is accepted instead of the device, see map( fd, offset ).
+	*/
+	template<AddressType physBase, size_t size>
+	struct Window {
+		static constexpr const AddressType getPhysBase() { return physBase; }
+		static constexpr const size_t getSize() { return size; }
+
+		/* Open device and map the window. "offset" is the file offset of physBase. Returns 0, or -errno */
+		static int open( const char* path = "/dev/mem", const off_t offset = static_cast<off_t>( physBase ) ) {
+			const int fd = ::open( path, O_RDWR | O_SYNC | O_CLOEXEC );
+			if ( fd < 0 ) {
+				return -errno;
+			}
+			const int result = map( fd, offset );
+			::close( fd );
+			return result;
+		}
+
+		/* Map the window from already opened file, file is not closed. Returns 0, or -errno */
+		static int map( const int fd, const off_t offset = static_cast<off_t>( physBase ) ) {
+			if ( isMapped() ) {
+				unmap();
+			}
+			const off_t pageSize = static_cast<off_t>( ::sysconf( _SC_PAGESIZE ) );
+			const off_t pageOffset = offset & ( pageSize - 1 );
+			void* const mapped = ::mmap( nullptr, size + pageOffset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset - pageOffset );
+			if ( MAP_FAILED == mapped ) {
+				return -errno;
+			}
+			_mapped = mapped;
+			_mappedSize = size + pageOffset;
+			bias = reinterpret_cast<AddressType>( mapped ) + static_cast<AddressType>( pageOffset ) - physBase;
+			return 0;
+		}
+
+		static void unmap() {
+			if ( isMapped() ) {
+				::munmap( _mapped, _mappedSize );
+				_mapped = nullptr;
+				_mappedSize = 0;
+				bias = 0;
+			}
+		}
+
+		static bool isMapped() { return ( nullptr != _mapped ); }
+
+		/* CPU address of physBase */
+		static AddressType getBase() { return physBase + bias; }
+
+		/* Mapped base - physBase, added to each register address */
+		static inline AddressType bias { 0 };
+
+	private:
+		static inline void* _mapped { nullptr };
+		static inline size_t _mappedSize { 0 };
+	};
+
+	/* Access backend, register address is resolved through mapped window */
+	template<typename WindowArg>
+	struct MappedIo {
+		typedef WindowArg Window;
+
+		template<typename ValueType>
+		static inline const ValueType read( const AddressType address ) {
+			return *reinterpret_cast<volatile ValueType* const>( address + Window::bias );
+		}
+
+		template<typename ValueType>
+		static inline void write( const AddressType address, const ValueType value ) {
+			*reinterpret_cast<volatile ValueType* const>( address + Window::bias ) = value;
+		}
+
+		template<typename ValueType>
+		static inline bool compareExchange( const AddressType address, ValueType& expected, const ValueType desired ) {
+			return __atomic_compare_exchange_n( reinterpret_cast<volatile ValueType* const>( address + Window::bias ), &expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+		}
+	};
+
+	/*
+		Block of registers of mapped window. Mapped base is resolved once, when block is created,
+		registers are accessed directly (DirectIo) by mapped base + offset. Window must be mapped before.
+	*/
+	template<typename WindowArg>
+	class MappedBlock : public Block< WindowArg::getPhysBase(), WindowArg::getSize(), DirectIo > {
+	public:
+		MappedBlock() : Block< WindowArg::getPhysBase(), WindowArg::getSize(), DirectIo >( WindowArg::getBase() ) {};
+	};
+
+	/* Scoped mapping, window is unmapped at the end of scope */
+	template<typename WindowArg>
+	class Mapping {
+	public:
+		Mapping( const char* path = "/dev/mem", const off_t offset = static_cast<off_t>( WindowArg::getPhysBase() ) ) : _result( WindowArg::open( path, offset ) ) {};
+		Mapping( const int fd, const off_t offset ) : _result( WindowArg::map( fd, offset ) ) {};
+		Mapping( const Mapping& ) = delete;
+		Mapping& operator=( const Mapping& ) = delete;
+		~Mapping() { WindowArg::unmap(); };
+
+		bool isMapped() const { return ( 0 == _result ); }
+		int result() const { return _result; }
+
+	private:
+		const int _result;
+	};
+
+} // Linux
+} // Register
@@ -0,0 +1,180 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Read-modify-write concurrency policies			*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+
+namespace Register {
+namespace Rmw {
+
+	/*
+		Concurrency policy of register read-modify-write, selected by register IoDescription.
+		Two contexts (threads, ISR) may modify different fields of the same register,
+		plain RMW loses one of updates.
+			None		- plain load, modify, store (single context, or register is owned by one context)
+			IrqMask		- interrupts are masked around RMW (bare-metal, single core)
+			Exclusive	- compare-exchange loop (LDREX/STREX, LDXR/STXR, lock cmpxchg). Only for memory,
+						  which supports exclusive access (not device memory), Io backend provides compareExchange()
+			StripedLock	- spinlock from table, selected by register address (threads, device memory)
+		Register with read-to-clear (RC) fields: read of RMW clears pending RC bits, so its IoDescription declares
+			Forbidden			- RMW is compile error, fields are written by register store, byte lane or SET/CLR aliases
+			ClearsReadToClear	- RMW by Inner policy, explicit opt-in: RC bits read by RMW are lost
+	*/
+
+	struct None {
+		static constexpr const bool exclusive = false;
+		struct Guard {
+			explicit Guard( const uintptr_t ) {};
+		};
+	};
+
+	/* Interrupt mask of current CPU, returns previous state */
+	template< typename Dummy = void >
+	inline uintptr_t irqSave(void) {
+#if defined(__aarch64__)
+		uint64_t flags;
+		asm volatile ("mrs %0, daif\n\tmsr daifset, #2" : "=r"(flags) :: "memory");
+		return flags;
+#elif defined(__arm__) && defined(__ARM_ARCH_PROFILE) && ( __ARM_ARCH_PROFILE == 'M' )
+		uint32_t flags;
+		asm volatile ("mrs %0, primask\n\tcpsid i" : "=r"(flags) :: "memory");
+		return flags;
+#elif defined(__arm__)
+		uint32_t flags;
+		asm volatile ("mrs %0, cpsr\n\tcpsid i" : "=r"(flags) :: "memory");
+		return flags;
+#elif defined(__x86_64__) || defined(__i386__)
+		uintptr_t flags;
+		asm volatile ("pushf\n\tpop %0\n\tcli" : "=r"(flags) :: "memory");
+		return flags;
+#else
+		static_assert( !std::is_same< Dummy, Dummy >::value, "Interrupt masking is not implemented for target architecture" );
+		return 0;
+#endif
+	}
+
+	template< typename Dummy = void >
+	inline void irqRestore( const uintptr_t flags ) {
+#if defined(__aarch64__)
+		asm volatile ("msr daif, %0" :: "r"(flags) : "memory");
+#elif defined(__arm__) && defined(__ARM_ARCH_PROFILE) && ( __ARM_ARCH_PROFILE == 'M' )
+		asm volatile ("msr primask, %0" :: "r"(flags) : "memory");
+#elif defined(__arm__)
+		asm volatile ("msr cpsr_c, %0" :: "r"(flags) : "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+		asm volatile ("push %0\n\tpopf" :: "r"(flags) : "memory", "cc");
+#else
+		static_assert( !std::is_same< Dummy, Dummy >::value, "Interrupt masking is not implemented for target architecture" );
+		(void)flags;
+#endif
+	}
+
+	/*
+		Interrupt masking is privileged: in user mode of hosted build (Linux and other OS) it faults (x86 cli)
+		or isn't allowed, so IrqMask is compile error there. Define REGISTER_BARE_METAL, when code runs
+		privileged under OS toolchain (kernel, bare-metal image built by linux toolchain).
+	*/
+#if defined(REGISTER_BARE_METAL) || !( defined(__linux__) || defined(__unix__) || defined(__APPLE__) || defined(_WIN32) )
+	static constexpr const bool BareMetal = true;
+#else
+	static constexpr const bool BareMetal = false;
+#endif
+
+	struct IrqMask {
+		static constexpr const bool exclusive = false;
+		/* Guard is template, so only its use is checked, not include of header */
+		template< typename Dummy = void >
+		class Masked {
+			static_assert( BareMetal || !std::is_same< Dummy, Dummy >::value, "IrqMask needs bare-metal (privileged) build, please use Exclusive or StripedLock policy, or define REGISTER_BARE_METAL" );
+		public:
+			explicit Masked( const uintptr_t ) : _flags( irqSave<Dummy>() ) {};
+			~Masked() { irqRestore<Dummy>( _flags ); };
+			Masked( const Masked& ) = delete;
+			Masked& operator=( const Masked& ) = delete;
+		private:
+			const uintptr_t _flags;
+		};
+		typedef Masked<> Guard;
+	};
+
+	struct Exclusive {
+		static constexpr const bool exclusive = true;
+	};
+
+	/* Table of spinlocks, registers of the same stripe share lock. Number of stripes is power of 2 */
+	template< size_t stripes = 64 >
+	struct StripedLock {
+		static_assert( ( stripes != 0 ) && ( ( stripes & ( stripes - 1 ) ) == 0 ), "Number of stripes must be power of 2" );
+		static constexpr const bool exclusive = false;
+
+		/* Lock is aligned to cache line, so stripes don't share cache line */
+		struct alignas(64) Lock {
+			std::atomic<bool> locked { false };
+		};
+
+		static inline Lock& getLock( const uintptr_t address ) {
+			return _locks[ ( address >> 2 ) & ( stripes - 1 ) ];
+		}
+
+		class Guard {
+		public:
+			explicit Guard( const uintptr_t address ) : _lock( getLock( address ) ) {
+				while ( _lock.locked.exchange( true, std::memory_order_acquire ) ) {
+					while ( _lock.locked.load( std::memory_order_relaxed ) ) {
+#if defined(__aarch64__) || defined(__arm__)
+						asm volatile ("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+						asm volatile ("pause" ::: "memory");
+#endif
+					}
+				}
+			};
+			~Guard() { _lock.locked.store( false, std::memory_order_release ); };
+			Guard( const Guard& ) = delete;
+			Guard& operator=( const Guard& ) = delete;
+		private:
+			Lock& _lock;
+		};
+
+	private:
+		static inline Lock _locks[ stripes ] {};
+	};
+
+	struct Forbidden {
+		static constexpr const bool exclusive = false;
+		struct Guard {
+			explicit Guard( const uintptr_t ) {};
+		};
+	};
+
+	template< typename Inner = None >
+	struct ClearsReadToClear : public Inner {};
+
+	/* Policy allows RC fields in register */
+	template< typename Policy >
+	struct ReadToClearSafe : std::false_type {};
+
+	template<>
+	struct ReadToClearSafe< Forbidden > : std::true_type {};
+
+	template< typename Inner >
+	struct ReadToClearSafe< ClearsReadToClear< Inner > > : std::true_type {};
+
+	/* Policy of register IoDescription, None when IoDescription doesn't declare it */
+	template< typename IoDescription, typename = void >
+	struct PolicyOf {
+		typedef None type;
+	};
+
+	template< typename IoDescription >
+	struct PolicyOf< IoDescription, std::void_t< typename IoDescription::RmwPolicy > > {
+		typedef typename IoDescription::RmwPolicy type;
+	};
+
+} // Rmw
+} // Register
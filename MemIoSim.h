@@ -0,0 +1,311 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Simulated register file access backend			*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <RegistersClass.h>
+
+namespace Register {
+namespace Sim {
+
+	/*
+		Memory backed register file, for host side testing and benchmarking.
+		Existing descriptions are retargeted to it by access backend, i.e.:
+			#define PERI_CRG_IO Register::Sim::Io
+			#include <hi3516ev200_pll_regs.h>
+
+			Register::Sim::AssertAfterReads apllLock( 0x1, 3, PllConfig0::getAddress() );
+			Register::Sim::AssertAfterReads vpllLock( 0x4, 3, PllConfig6::getAddress() );
+			Register::Sim::File::instance().add( PllLockStatus::getAddress(), 0, Register::Sim::Mode::ReadOnly )
+				.attach( PllLockStatus::getAddress(), apllLock )
+				.attach( PllLockStatus::getAddress(), vpllLock );
+
+		Register may have several behaviors, they are applied in order of attach.
+		Behavior observes writes of its trigger register only, so store costs nothing for other behaviors.
+		Registers are kept sorted by address, access is a binary search without allocation.
+	*/
+
+	enum class Mode {
+		ReadWrite,
+		ReadOnly,
+		WriteOnly
+	};
+
+	/* Per-register behavior */
+	class Behavior {
+	public:
+		virtual ~Behavior() {};
+		/* Register is read by CPU, value may be changed by behavior */
+		virtual void onRead( uint64_t& value ) { (void)value; };
+		/* Trigger register is written by CPU */
+		virtual void onWrite( const AddressType address, const uint64_t value ) { (void)address; (void)value; };
+		/* Register file is reset */
+		virtual void onReset() {};
+		/* Register, which writes are observed by onWrite(), 0 - writes aren't observed */
+		virtual AddressType getTrigger() const { return 0; };
+	};
+
+	/* Bits of mask are asserted after N reads. Write to trigger address deasserts them and restarts countdown */
+	class AssertAfterReads : public Behavior {
+	public:
+		AssertAfterReads( const uint64_t mask, const uint32_t reads, const AddressType trigger = 0 ) :
+			_mask( mask ), _reads( reads ), _trigger( trigger ), _left( reads ) {};
+
+		void onRead( uint64_t& value ) override {
+			if ( _left > 0 ) {
+				_left--;
+				value &= ~_mask;
+			} else {
+				value |= _mask;
+			}
+		}
+
+		void onWrite( const AddressType address, const uint64_t ) override {
+			if ( ( 0 != _trigger ) && ( address == _trigger ) ) {
+				_left = _reads;
+			}
+		}
+
+		void onReset() override { _left = _reads; }
+
+		AddressType getTrigger() const override { return _trigger; }
+
+	private:
+		const uint64_t _mask;
+		const uint32_t _reads;
+		const AddressType _trigger;
+		uint32_t _left;
+	};
+
+	/* Bits of mask are asserted after delay. Write to trigger address deasserts them and restarts delay */
+	class AssertAfterTime : public Behavior {
+	public:
+		typedef std::chrono::steady_clock Clock;
+
+		AssertAfterTime( const uint64_t mask, const std::chrono::nanoseconds delay, const AddressType trigger = 0 ) :
+			_mask( mask ), _delay( delay ), _trigger( trigger ), _start( Clock::now() ) {};
+
+		void onRead( uint64_t& value ) override {
+			if ( ( Clock::now() - _start ) < _delay ) {
+				value &= ~_mask;
+			} else {
+				value |= _mask;
+			}
+		}
+
+		void onWrite( const AddressType address, const uint64_t ) override {
+			if ( ( 0 != _trigger ) && ( address == _trigger ) ) {
+				_start = Clock::now();
+			}
+		}
+
+		void onReset() override { _start = Clock::now(); }
+
+		AddressType getTrigger() const override { return _trigger; }
+
+	private:
+		const uint64_t _mask;
+		const std::chrono::nanoseconds _delay;
+		const AddressType _trigger;
+		Clock::time_point _start;
+	};
+
+	/* Simulated register */
+	struct Cell {
+		uint64_t value { 0 };
+		uint64_t resetValue { 0 };
+		Mode mode { Mode::ReadWrite };
+		/* Behaviors of register value, in order of attach */
+		std::vector< Behavior* > behaviors;
+		uint64_t reads { 0 };
+		uint64_t writes { 0 };
+	};
+
+	/* Access counters of whole file */
+	struct Counters {
+		uint64_t reads { 0 };
+		uint64_t writes { 0 };
+		/* Access to unknown register, write to read-only or read of write-only register */
+		uint64_t violations { 0 };
+	};
+
+	class File {
+	public:
+		static File& instance() {
+			static File file;
+			return file;
+		}
+
+		/* Declare register, with reset value and access mode */
+		File& add( const AddressType address, const uint64_t resetValue = 0, const Mode mode = Mode::ReadWrite ) {
+			Cell& cell = insert( address );
+			cell.value = resetValue;
+			cell.resetValue = resetValue;
+			cell.mode = mode;
+			return *this;
+		}
+
+		/* Attach behavior to register, behavior is owned by caller. Behavior with trigger observes writes of trigger register */
+		File& attach( const AddressType address, Behavior& behavior ) {
+			insert( address ).behaviors.push_back( &behavior );
+			if ( 0 != behavior.getTrigger() ) {
+				_observers.push_back( Observer { behavior.getTrigger(), &behavior } );
+			}
+			return *this;
+		}
+
+		/* Reset values, behaviors and counters. Registers and behaviors are kept */
+		void reset() {
+			for ( Cell& cell : _cells ) {
+				cell.value = cell.resetValue;
+				cell.reads = 0;
+				cell.writes = 0;
+				for ( Behavior* const behavior : cell.behaviors ) {
+					behavior->onReset();
+				}
+			}
+			_counters = Counters();
+		}
+
+		/* Drop all registers and behaviors */
+		void clear() {
+			_addresses.clear();
+			_cells.clear();
+			_observers.clear();
+			_counters = Counters();
+		}
+
+		template<typename ValueType>
+		const ValueType read( const AddressType address ) {
+			_counters.reads++;
+			Cell* const cell = find( address );
+			if ( nullptr == cell ) {
+				_counters.violations++;
+				return 0;
+			}
+			cell->reads++;
+			if ( Mode::WriteOnly == cell->mode ) {
+				_counters.violations++;
+				return 0;
+			}
+			for ( Behavior* const behavior : cell->behaviors ) {
+				behavior->onRead( cell->value );
+			}
+			return static_cast<ValueType>( cell->value );
+		}
+
+		/* Narrow store is merged into its lane of register value (byte strobes) */
+		template<typename ValueType>
+		void write( const AddressType address, const ValueType value ) {
+			_counters.writes++;
+			AddressType cellAddress = address;
+			Cell* cell = find( address );
+			if ( ( nullptr == cell ) && ( sizeof( ValueType ) < sizeof( uint32_t ) ) ) {
+				cellAddress = address & ~static_cast<AddressType>( sizeof( uint32_t ) - 1 );
+				cell = find( cellAddress );
+			}
+			if ( nullptr == cell ) {
+				_counters.violations++;
+				return;
+			}
+			cell->writes++;
+			if ( Mode::ReadOnly == cell->mode ) {
+				/* Store is lost, observers don't see it */
+				_counters.violations++;
+				return;
+			} else if ( sizeof( ValueType ) < sizeof( uint32_t ) ) {
+				const size_t shift = ( address - cellAddress ) * 8;
+				const uint64_t laneMask = ( ( static_cast<uint64_t>( 1 ) << ( sizeof( ValueType ) * 8 ) ) - 1 ) << shift;
+				cell->value = ( cell->value & ~laneMask ) | ( static_cast<uint64_t>( value ) << shift );
+			} else {
+				cell->value = static_cast<uint64_t>( value );
+			}
+			for ( const Observer& observer : _observers ) {
+				if ( observer.trigger == cellAddress ) {
+					observer.behavior->onWrite( cellAddress, static_cast<uint64_t>( value ) );
+				}
+			}
+		}
+
+		/* Value, without side effects and counters */
+		const uint64_t peek( const AddressType address ) const {
+			const auto item = std::lower_bound( _addresses.begin(), _addresses.end(), address );
+			return ( ( _addresses.end() == item ) || ( *item != address ) ) ? 0 : _cells[ item - _addresses.begin() ].value;
+		}
+
+		/* Set value, as hardware does */
+		void poke( const AddressType address, const uint64_t value ) {
+			insert( address ).value = value;
+		}
+
+		/* Register, nullptr when it isn't declared (inspection doesn't declare it) */
+		const Cell* cell( const AddressType address ) { return find( address ); }
+		const Counters& counters() const { return _counters; }
+
+	private:
+		File() {};
+		File( const File& ) = delete;
+		File& operator=( const File& ) = delete;
+
+		Cell* find( const AddressType address ) {
+			const auto item = std::lower_bound( _addresses.begin(), _addresses.end(), address );
+			return ( ( _addresses.end() == item ) || ( *item != address ) ) ? nullptr : &_cells[ item - _addresses.begin() ];
+		}
+
+		Cell& insert( const AddressType address ) {
+			const auto item = std::lower_bound( _addresses.begin(), _addresses.end(), address );
+			const size_t index = item - _addresses.begin();
+			if ( ( _addresses.end() == item ) || ( *item != address ) ) {
+				_addresses.insert( item, address );
+				_cells.insert( _cells.begin() + index, Cell() );
+			}
+			return _cells[ index ];
+		}
+
+	private:
+		/* Behavior, which observes writes of trigger register */
+		struct Observer {
+			AddressType trigger;
+			Behavior* behavior;
+		};
+
+		/* Sorted addresses of registers, and registers of the same index */
+		std::vector< AddressType > _addresses;
+		std::vector< Cell > _cells;
+		std::vector< Observer > _observers;
+		Counters _counters;
+	};
+
+	/* Access backend, register is accessed in simulated register file */
+	struct Io {
+		template<typename ValueType>
+		static inline const ValueType read( const AddressType address ) {
+			return File::instance().read<ValueType>( address );
+		}
+
+		template<typename ValueType>
+		static inline void write( const AddressType address, const ValueType value ) {
+			File::instance().write<ValueType>( address, value );
+		}
+
+		/* Register file is single threaded, exchange always succeeds when value is expected one */
+		template<typename ValueType>
+		static inline bool compareExchange( const AddressType address, ValueType& expected, const ValueType desired ) {
+			const ValueType value = File::instance().read<ValueType>( address );
+			if ( value != expected ) {
+				expected = value;
+				return false;
+			}
+			File::instance().write<ValueType>( address, desired );
+			return true;
+		}
+	};
+
+} // Sim
+} // Register
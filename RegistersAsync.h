@@ -0,0 +1,244 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Coroutine waits for register conditions			*/
+
+#pragma once
+
+#if ( __cplusplus < 202002L ) || !defined(__cpp_impl_coroutine)
+#error "RegistersAsync.h requires C++20 coroutines"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <RegistersClass.h>
+#include <RegistersWait.h>
+
+namespace Register {
+namespace Async {
+
+	/*
+		Many tasks wait for hardware conditions, driven by single executor loop.
+		Waiters of the same register are kept together, so each poll pass reads each
+		register once and resumes all waiters, which condition holds.
+		Executor is single threaded: tasks are resumed by the thread, which calls Poll()/Run().
+
+			Register::Async::Task pllTask() {
+				const Register::Wait::Status status = co_await Register::Until< PllLockStatus, PllLockStatus::APll >(
+								PllLockStatus::APll::Type::Locked ).For( std::chrono::milliseconds(10) );
+				if ( Register::Wait::Status::Done != status ) { ... }
+				...
+			}
+			pllTask();
+			Register::Async::Executor::instance().Run();
+
+		Result of co_await is kept in local: GCC 12 crashes on resume, when co_await is in condition of if,
+		which has co_return.
+	*/
+
+	typedef std::chrono::steady_clock Clock;
+
+	/* Condition of suspended coroutine, it lives in coroutine frame */
+	struct Waiter {
+		AddressType address { 0 };
+		uint64_t mask { 0 };
+		uint64_t value { 0 };
+		/* Bus read of register, by its access backend and IoDescription */
+		uint64_t ( *read )( const AddressType ) { nullptr };
+		bool timed { false };
+		/* Deadline is counted from suspend ( co_await ), not from construction of awaitable */
+		Clock::duration timeout {};
+		Clock::time_point deadline {};
+		std::coroutine_handle<> handle {};
+		Waiter* next { nullptr };
+		Wait::Status status { Wait::Status::Done };
+		/* The last read register value */
+		uint64_t regValue { 0 };
+	};
+
+	template< typename Reg >
+	inline uint64_t readRegister( const AddressType address ) {
+		return static_cast<uint64_t>( ioRead<Reg, typename Reg::Value::Type>( address ) );
+	}
+
+	class Executor {
+	public:
+		Executor() {};
+		Executor( const Executor& ) = delete;
+		Executor& operator=( const Executor& ) = delete;
+
+		static Executor& instance() {
+			static Executor executor;
+			return executor;
+		}
+
+		/* Waiter is placed after the last waiter of the same register, or at the end */
+		void Add( Waiter& waiter ) {
+			Waiter** link = &_head;
+			Waiter** groupEnd = nullptr;
+			while ( nullptr != *link ) {
+				if ( isSameRegister( **link, waiter ) ) {
+					groupEnd = &( *link )->next;
+				}
+				link = &( *link )->next;
+			}
+			if ( nullptr == groupEnd ) {
+				groupEnd = link;
+			}
+			waiter.next = *groupEnd;
+			*groupEnd = &waiter;
+			_pending++;
+		}
+
+		/*
+			Single pass: each register is read once, waiters with true condition or expired deadline are resumed.
+			Returns number of resumed waiters.
+		*/
+		size_t Poll() {
+			Waiter* ready = nullptr;
+			Waiter** readyTail = &ready;
+			Clock::time_point now {};
+			bool nowValid = false;
+			AddressType groupAddress = 0;
+			uint64_t ( *groupRead )( const AddressType ) = nullptr;
+			uint64_t regValue = 0;
+
+			Waiter** link = &_head;
+			while ( nullptr != *link ) {
+				Waiter* const waiter = *link;
+				if ( ( nullptr == groupRead ) || ( groupAddress != waiter->address ) || ( groupRead != waiter->read ) ) {
+					groupAddress = waiter->address;
+					groupRead = waiter->read;
+					regValue = groupRead( groupAddress );
+				}
+				bool resume = ( ( regValue & waiter->mask ) == waiter->value );
+				waiter->status = Wait::Status::Done;
+				if ( !resume && waiter->timed ) {
+					if ( !nowValid ) {
+						now = Clock::now();
+						nowValid = true;
+					}
+					if ( now >= waiter->deadline ) {
+						waiter->status = Wait::Status::Timeout;
+						resume = true;
+					}
+				}
+				if ( resume ) {
+					waiter->regValue = regValue;
+					*link = waiter->next;
+					waiter->next = nullptr;
+					*readyTail = waiter;
+					readyTail = &waiter->next;
+				} else {
+					link = &waiter->next;
+				}
+			}
+
+			/* Resumed task may add new waiters, or finish and destroy its waiter */
+			size_t resumed = 0;
+			while ( nullptr != ready ) {
+				Waiter* const waiter = ready;
+				ready = waiter->next;
+				waiter->next = nullptr;
+				_pending--;
+				resumed++;
+				waiter->handle.resume();
+			}
+			return resumed;
+		}
+
+		/* Poll until there are no waiters, CPU relax hint between idle passes */
+		void Run() {
+			while ( !Empty() ) {
+				if ( 0 == Poll() ) {
+					Wait::cpuRelax();
+				}
+			}
+		}
+
+		bool Empty() const { return ( nullptr == _head ); }
+		size_t Pending() const { return _pending; }
+
+	private:
+		static bool isSameRegister( const Waiter& a, const Waiter& b ) {
+			return ( a.address == b.address ) && ( a.read == b.read );
+		}
+
+	private:
+		Waiter* _head { nullptr };
+		size_t _pending { 0 };
+	};
+
+	/* Awaitable condition, resumes with Wait::Status */
+	class Condition {
+	public:
+		Condition( const AddressType address, const uint64_t mask, const uint64_t value, uint64_t ( *read )( const AddressType ) ) {
+			_waiter.address = address;
+			_waiter.mask = mask;
+			_waiter.value = value;
+			_waiter.read = read;
+		}
+
+		/* Executor, which polls condition (default is Executor::instance()) */
+		inline Condition On( Executor& executor ) const {
+			Condition condition( *this );
+			condition._executor = &executor;
+			return condition;
+		}
+
+		/* Condition is resumed with Wait::Status::Timeout after timeout, which starts at co_await */
+		inline Condition For( const Clock::duration timeout ) const {
+			Condition condition( *this );
+			condition._waiter.timed = true;
+			condition._waiter.timeout = timeout;
+			return condition;
+		}
+
+		/* Condition is checked by one read before suspend */
+		inline bool await_ready() {
+			_waiter.regValue = _waiter.read( _waiter.address );
+			return ( ( _waiter.regValue & _waiter.mask ) == _waiter.value );
+		}
+
+		inline void await_suspend( const std::coroutine_handle<> handle ) {
+			_waiter.handle = handle;
+			if ( _waiter.timed ) {
+				_waiter.deadline = Clock::now() + _waiter.timeout;
+			}
+			_executor->Add( _waiter );
+		}
+
+		inline Wait::Status await_resume() const { return _waiter.status; }
+
+		/* Register value, which resumed waiter */
+		inline uint64_t getValue() const { return _waiter.regValue; }
+
+	private:
+		Waiter _waiter {};
+		Executor* _executor { &Executor::instance() };
+	};
+
+	/* Detached task, it is started at once and frame is freed on completion */
+	struct Task {
+		struct promise_type {
+			Task get_return_object() { return Task(); }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+} // Async
+
+	/* Awaitable: fields are equal to values. Masks are computed at compile time, as WaitFor does */
+	template< typename Reg, typename... Fields >
+	inline Async::Condition Until( typename Fields::Type... args ) {
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>();
+		const typename Reg::Value::Type maskedValue = getRegValueInt<Reg, Fields...>( args... ) & ConcatMask;
+		return Async::Condition( Reg::getAddress(), ConcatMask, maskedValue, &Async::readRegister<Reg> );
+	}
+
+} // Register
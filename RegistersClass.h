@@ -7,20 +7,298 @@
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
+#include <tuple>
+#include <MemIoDescription.h>
+
+#if defined(REGISTER_TRACE)
+#include <RegistersTrace.h>
+#endif
 
 namespace Register {
-	typedef uint32_t AddressType;
+	typedef uintptr_t AddressType;
 	typedef uint32_t DefaultValueType;
 
+	/* Barriers, see MemIoBarrier.h. Level is selected by register IoDescription */
+	template<Ordering order = Ordering::Complete>
 	inline void preRead(void) {
-		//asm("dsb ld");
+		barrier<order, BarrierType::Load>();
 	}
 
+	template<Ordering order = Ordering::Complete>
 	inline void postWrite(void){
-		//asm("dsb st");
+		barrier<order, BarrierType::Store>();
+	}
+
+	/* Direct access backend, register address is CPU address (bare-metal) */
+	struct DirectIo {
+		template<typename ValueType>
+		static inline const ValueType read( const AddressType address ) {
+			return *reinterpret_cast<volatile ValueType* const>( address );
+		}
+
+		template<typename ValueType>
+		static inline void write( const AddressType address, const ValueType value ) {
+			*reinterpret_cast<volatile ValueType* const>( address ) = value;
+		}
+
+		/* Exclusive update (Rmw::Exclusive), expected is updated by current value on failure */
+		template<typename ValueType>
+		static inline bool compareExchange( const AddressType address, ValueType& expected, const ValueType desired ) {
+			return __atomic_compare_exchange_n( reinterpret_cast<volatile ValueType* const>( address ), &expected, desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+		}
+	};
+
+	/* Plain bus access through backend, without any barrier */
+	template<typename Io, typename ValueType>
+	inline const ValueType readRaw( const AddressType address ) {
+		return Io::template read<ValueType>( address );
+	}
+
+	template<typename Io, typename ValueType>
+	inline void writeRaw( const AddressType address, const ValueType value ) {
+		Io::template write<ValueType>( address, value );
+	}
+
+	/*
+		Register access of bus width (BusDataType of IoDescription). Register wider then bus
+		is accessed by several bus accesses, in split order of IoDescription.
+		Device memory accesses are observed in program order, so there is no barrier between them.
+	*/
+	template<typename Owner, typename ValueType>
+	inline const ValueType readBus( const AddressType address ) {
+		typedef typename Owner::IoDescription::BusDataType BusType;
+		if constexpr ( sizeof( ValueType ) <= sizeof( BusType ) ) {
+			return readRaw<typename Owner::Io, ValueType>( address );
+		} else {
+			static_assert( ( sizeof( ValueType ) % sizeof( BusType ) ) == 0, "Register size must be multiple of bus size" );
+			constexpr const size_t parts = sizeof( ValueType ) / sizeof( BusType );
+			ValueType value = 0;
+			for ( size_t part = 0; part < parts; part++ ) {
+				const size_t index = ( SplitOrder::LowFirst == Owner::IoDescription::Access::Read::split ) ? part : ( parts - 1 - part );
+				value |= static_cast<ValueType>( readRaw<typename Owner::Io, BusType>( address + ( index * sizeof( BusType ) ) ) ) << ( index * sizeof( BusType ) * 8 );
+			}
+			return value;
+		}
+	}
+
+	template<typename Owner, typename ValueType>
+	inline void writeBus( const AddressType address, const ValueType value ) {
+		typedef typename Owner::IoDescription::BusDataType BusType;
+		if constexpr ( sizeof( ValueType ) <= sizeof( BusType ) ) {
+			writeRaw<typename Owner::Io, ValueType>( address, value );
+		} else {
+			static_assert( ( sizeof( ValueType ) % sizeof( BusType ) ) == 0, "Register size must be multiple of bus size" );
+			constexpr const size_t parts = sizeof( ValueType ) / sizeof( BusType );
+			for ( size_t part = 0; part < parts; part++ ) {
+				const size_t index = ( SplitOrder::LowFirst == Owner::IoDescription::Access::Write::split ) ? part : ( parts - 1 - part );
+				writeRaw<typename Owner::Io, BusType>( address + ( index * sizeof( BusType ) ), static_cast<BusType>( value >> ( index * sizeof( BusType ) * 8 ) ) );
+			}
+		}
+	}
+
+	/* Cache maintenance, for registers placed in cached memory */
+	inline void cacheInvalidate( const AddressType address, const size_t size ) {
+		(void)address; (void)size;
+	}
+
+	inline void cacheClean( const AddressType address, const size_t size ) {
+		(void)address; (void)size;
+	}
+
+	/*
+		Register IoDescription (see MemIoDescription.h) rules.
+		Everything is resolved at compile time, so barriers and cache maintenance are emitted
+		only for registers, which ask for them, and masks are folded into the constants.
+	*/
+	template<typename Owner>
+	inline void syncRead( const AddressType address, const size_t size ) {
+		typedef typename Owner::IoDescription::Access::Read::Sync Sync;
+		if constexpr ( Sync::cpu ) {
+			preRead<Sync::order>();
+		}
+		if constexpr ( Sync::cache ) {
+			cacheInvalidate( address, size );
+		}
+	}
+
+	template<typename Owner>
+	inline void syncWrite( const AddressType address, const size_t size ) {
+		typedef typename Owner::IoDescription::Access::Write::Sync Sync;
+		if constexpr ( Sync::cache ) {
+			cacheClean( address, size );
+		}
+		if constexpr ( Sync::cpu ) {
+			postWrite<Sync::order>();
+		}
+	}
+
+	template<typename Owner, typename ValueType>
+	inline constexpr const ValueType modifyRead( ValueType value ) {
+		typedef typename Owner::IoDescription::Modification::Read Modification;
+		if constexpr ( Modification::AndMask::enabled ) {
+			value &= static_cast<ValueType>( Modification::AndMask::value );
+		}
+		if constexpr ( Modification::OrMask::enabled ) {
+			value |= static_cast<ValueType>( Modification::OrMask::value );
+		}
+		return value;
+	}
+
+	template<typename Owner, typename ValueType>
+	inline constexpr const ValueType modifyWrite( ValueType value ) {
+		typedef typename Owner::IoDescription::Modification::Write Modification;
+		if constexpr ( Modification::AndMask::enabled ) {
+			value &= static_cast<ValueType>( Modification::AndMask::value );
+		}
+		if constexpr ( Modification::OrMask::enabled ) {
+			value |= static_cast<ValueType>( Modification::OrMask::value );
+		}
+		return value;
+	}
+
+	/* Access tracing hooks, see RegistersTrace.h. Mask is the bits accessor is interested in */
+	template<typename ValueType>
+	inline void traceRead( const AddressType address, const ValueType mask, const ValueType value ) {
+#if defined(REGISTER_TRACE)
+		Trace::record( Trace::Op::Read, address, mask, value );
+#else
+		(void)address; (void)mask; (void)value;
+#endif
+	}
+
+	template<typename ValueType>
+	inline void traceWrite( const AddressType address, const ValueType mask, const ValueType value ) {
+#if defined(REGISTER_TRACE)
+		Trace::record( Trace::Op::Write, address, mask, value );
+#else
+		(void)address; (void)mask; (void)value;
+#endif
+	}
+
+	/*
+		Bus access depends only on backend and IoDescription of register. Register description ( Owner )
+		is reduced to IoOwner by callers ( ioWrite<IoOwnerOf< Owner >, ...> ), so registers of the same backend
+		and IoDescription share instantiations of bus access helpers. Otherwise each register of large map
+		has its own copies of them (compile time, -O0 code).
+	*/
+	template< typename IoArg, typename IoDescriptionArg >
+	struct IoOwner {
+		typedef IoArg Io;
+		typedef IoDescriptionArg IoDescription;
+	};
+
+	template< typename Owner >
+	using IoOwnerOf = IoOwner< typename Owner::Io, typename Owner::IoDescription >;
+
+	/* Bus access of register, with synchronization and modification rules of register IoDescription */
+	template<typename Owner, typename ValueType>
+	inline const ValueType ioRead( const AddressType address, const ValueType mask = ~static_cast<ValueType>( 0 ) ) {
+		typedef IoOwnerOf< Owner > Bus;
+		static_assert( Bus::IoDescription::Access::Read::readable, "Register is not readable" );
+		syncRead<Bus>( address, sizeof( ValueType ) );
+		const ValueType value = modifyRead<Bus, ValueType>( readBus<Bus, ValueType>( address ) );
+		traceRead<ValueType>( address, mask, value );
+		return value;
+	}
+
+	template<typename Owner, typename ValueType>
+	inline void ioWrite( const AddressType address, const ValueType value, const ValueType mask = ~static_cast<ValueType>( 0 ) ) {
+		typedef IoOwnerOf< Owner > Bus;
+		static_assert( Bus::IoDescription::Access::Write::writable, "Register is not writable" );
+		const ValueType valueToWrite = modifyWrite<Bus, ValueType>( value );
+		writeBus<Bus, ValueType>( address, valueToWrite );
+		traceWrite<ValueType>( address, mask, valueToWrite );
+		syncWrite<Bus>( address, sizeof( ValueType ) );
+	}
+
+	/* Read-modify-write of mask bits, protected by concurrency policy of register IoDescription (see MemIoRmw.h) */
+	template<typename Owner, typename ValueType>
+	inline void ioModify( const AddressType address, const ValueType mask, const ValueType value ) {
+		typedef IoOwnerOf< Owner > Bus;
+		typedef typename Rmw::PolicyOf< typename Bus::IoDescription >::type Policy;
+		static_assert( !std::is_same< Policy, Rmw::Forbidden >::value, "Register has RC fields, RMW is forbidden (its read clears them): please write all fields, or use Rmw::ClearsReadToClear policy" );
+		if constexpr ( Policy::exclusive ) {
+			static_assert( sizeof( ValueType ) <= sizeof( typename Bus::IoDescription::BusDataType ), "Register wider then bus can't be modified exclusively" );
+			static_assert( Bus::IoDescription::Access::Read::readable && Bus::IoDescription::Access::Write::writable, "Register is not readable or writable" );
+			syncRead<Bus>( address, sizeof( ValueType ) );
+			ValueType expected = readRaw<typename Bus::Io, ValueType>( address );
+			ValueType valueToWrite;
+			do {
+				valueToWrite = modifyWrite<Bus, ValueType>( ( modifyRead<Bus, ValueType>( expected ) & ~( mask ) ) | value );
+			} while ( !Bus::Io::template compareExchange<ValueType>( address, expected, valueToWrite ) );
+			traceRead<ValueType>( address, mask, expected );
+			traceWrite<ValueType>( address, mask, valueToWrite );
+			syncWrite<Bus>( address, sizeof( ValueType ) );
+		} else {
+			const typename Policy::Guard guard( address );
+			ValueType regValue = ioRead<Bus, ValueType>( address, mask );
+			regValue &= ~( mask );
+			regValue |= value;
+			ioWrite<Bus, ValueType>( address, regValue, mask );
+		}
+	}
+
+	/* Register has no concurrency policy, RMW is plain load and store */
+	template<typename Owner>
+	constexpr const bool isPlainRmw() {
+		return std::is_same< typename Rmw::PolicyOf< typename Owner::IoDescription >::type, Rmw::None >::value;
+	}
+
+	/* Register forbids RMW (it has RC fields) */
+	template<typename Owner>
+	constexpr const bool isRmwForbidden() {
+		return std::is_same< typename Rmw::PolicyOf< typename Owner::IoDescription >::type, Rmw::Forbidden >::value;
+	}
+
+	/* Byte lane of register write: size and offset (bytes), size is 0 when there is no lane */
+	struct WriteLane {
+		size_t size;
+		size_t offset;
+	};
+
+	/*
+		The narrowest aligned byte or halfword lane, which contains all written bits (fieldsMask),
+		and which bits are all known (coverMask: written, reserved and write-one bits).
+		Store to the lane replaces RMW, when bus has byte strobes (IoDescription Access::Write::lanes).
+	*/
+	template<typename Owner, typename ValueType>
+	constexpr const WriteLane getWriteLane( const ValueType fieldsMask, const ValueType coverMask ) {
+		if constexpr ( Owner::IoDescription::Access::Write::lanes ) {
+			for ( size_t size = 1; size < sizeof( ValueType ) && size <= sizeof( uint16_t ); size *= 2 ) {
+				for ( size_t offset = 0; offset < sizeof( ValueType ); offset += size ) {
+					const ValueType laneMask = static_cast<ValueType>( ( ( static_cast<ValueType>( 1 ) << ( size * 8 ) ) - 1 ) << ( offset * 8 ) );
+					if ( ( 0 == ( fieldsMask & ~laneMask ) ) && ( 0 == ( laneMask & ~coverMask ) ) ) {
+						return WriteLane { size, offset };
+					}
+				}
+			}
+		}
+		return WriteLane { 0, 0 };
+	}
+
+	/* Store of register lane, value is whole register value */
+	template<typename Owner, typename ValueType, size_t laneSize, size_t laneOffset>
+	inline void ioWriteLane( const AddressType address, const ValueType value, const ValueType mask ) {
+		static_assert( Owner::IoDescription::Access::Write::writable, "Register is not writable" );
+		typedef typename std::conditional< ( laneSize == 1 ), uint8_t, uint16_t >::type LaneType;
+#if defined(__BYTE_ORDER__) && ( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
+		constexpr const AddressType laneAddress = sizeof( ValueType ) - laneOffset - laneSize;
+#else
+		constexpr const AddressType laneAddress = laneOffset;
+#endif
+		typedef IoOwnerOf< Owner > Bus;
+		const ValueType valueToWrite = modifyWrite<Bus, ValueType>( value );
+		writeRaw<typename Bus::Io, LaneType>( address + laneAddress, static_cast<LaneType>( valueToWrite >> ( laneOffset * 8 ) ) );
+		traceWrite<ValueType>( address, mask, valueToWrite );
+		syncWrite<Bus>( address, sizeof( ValueType ) );
 	}
 
-	template<size_t msb = 0, size_t lsb = 0, typename FieldValueTypeArg = DefaultValueType, typename RegisterValueTypeArg = DefaultValueType >
+	/* Default type of value with given number of bits: 32 bit, or 64 bit for wider values */
+	template<size_t bits>
+	using BitsValueType = typename std::conditional< ( bits > ( sizeof( DefaultValueType ) * 8 ) ), uint64_t, DefaultValueType >::type;
+
+	template<size_t msb = 0, size_t lsb = 0, typename FieldValueTypeArg = BitsValueType< msb - lsb + 1 >, typename RegisterValueTypeArg = BitsValueType< msb + 1 > >
 	struct Field {
 		typedef RegisterValueTypeArg 	RegisterValueType;
 		typedef FieldValueTypeArg 		FieldValueType;
@@ -46,51 +324,83 @@ namespace Register {
 		ReadOnly,
 		WriteOnly,
 		ReadWrite,
-		Reserved
+		Reserved,
+		/* Writing 1 clears bit, writing 0 has no effect (interrupt status) */
+		WriteOneToClear,
+		/* Writing 1 sets bit, writing 0 has no effect */
+		WriteOneToSet,
+		/* Read only, reading clears bits */
+		ReadToClear,
+		/* Bits are set and cleared by writing 1 to SET and CLR alias registers */
+		SetClear
 	};
 
-	template<size_t bitNo = 0, typename FieldValueTypeArg = DefaultValueType, typename RegisterValueTypeArg = DefaultValueType >
+	template<size_t bitNo = 0, typename FieldValueTypeArg = DefaultValueType, typename RegisterValueTypeArg = BitsValueType< bitNo + 1 > >
 	struct Bit : public Field< bitNo, bitNo, FieldValueTypeArg, RegisterValueTypeArg > {};
 
-	template< AddressType address, typename Descr >
-	struct RW {
+	/* Bits given by precomputed mask, i.e. reserved bits of generated register map: RS< getAddress(), BitMask< 0x88000000 > > */
+	template<uint64_t mask>
+	struct BitMask {
+		static constexpr const uint64_t getBitMask() { return mask; };
+	};
+
+	template<AddressType address, typename RegValueType = DefaultValueType, typename IoArg = DirectIo, typename IoDescriptionArg = MemIoDescription<RegValueType> >
+	struct Description;
+
+	/*
+		Value type of field accessor ( Field::Type ) and types of register description are declared by shared base.
+		Each typedef makes new variant of integer type, and GCC searches all variants, when it builds qualified (const) type,
+		so typedef in each field of large register map makes compile time quadratic in number of registers.
+	*/
+	template< typename ValueType >
+	struct FieldType {
+		typedef ValueType Type;
+	};
+
+	template< typename RegValueType, typename IoArg, typename IoDescriptionArg >
+	struct RegisterTypes {
+		typedef IoArg Io;
+		typedef IoDescriptionArg IoDescription;
+		typedef RegValueType RegisterValueType;
+	};
+
+	template< AddressType address, typename Descr, typename Owner = Description<address> >
+	struct RW : public FieldType< typename Descr::FieldValueType > {
 		static constexpr const AccessMode Policy = AccessMode::ReadWrite;
 		typedef Descr Description;
-		typedef typename Descr::FieldValueType Type;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
 
 		static inline constexpr const AddressType getAddress() {
 			return address;
 		}
 
 		static inline const void set(const typename Descr::FieldValueType value) {
-			const typename Descr::RegisterValueType valueToWrite = (static_cast<const typename Descr::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			constexpr const WriteLane Lane = getWriteLane< IoOwnerOf< Owner >, typename Owner::RegisterValueType >( Descr::getBitMask(), Descr::getBitMask() );
 			/* Read - Modify - Write */
-			if constexpr ( Descr::getBitCount() == ( sizeof( typename Descr::RegisterValueType ) * 8) ) {
-				*reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() ) = valueToWrite;
-				postWrite();
+			if constexpr ( Descr::getBitCount() == ( sizeof( typename Owner::RegisterValueType ) * 8) ) {
+				ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), valueToWrite, Descr::getBitMask() );
+			} else if constexpr ( 0 != Lane.size ) {
+				ioWriteLane<IoOwnerOf< Owner >, typename Owner::RegisterValueType, Lane.size, Lane.offset>( getAddress(), valueToWrite, Descr::getBitMask() );
 			} else {
-				preRead();
-				typename Descr::RegisterValueType regValue = *reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() );
-				regValue &= ~( Descr::getBitMask() );
-				regValue |= valueToWrite;
-				*reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() ) = regValue;
-				postWrite();
+				ioModify<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask(), valueToWrite );
 			}
 		}
 
 		static inline const typename Descr::FieldValueType get() {
-			preRead();
-			const typename Descr::RegisterValueType regValue = *reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() );
+			const typename Owner::RegisterValueType regValue = ioRead<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask() );
 			return static_cast<const typename Descr::FieldValueType>( ( regValue >> Descr::getLsb() ) & Descr::getLsbMask() );
 		}
 
 	};
 
-	template< AddressType address, typename Descr >
-	struct WO {
+	template< AddressType address, typename Descr, typename Owner = Description<address> >
+	struct WO : public FieldType< typename Descr::FieldValueType > {
 		static constexpr const AccessMode Policy = AccessMode::WriteOnly;
 		typedef Descr Description;
-		typedef typename Descr::FieldValueType Type;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
 
 		static inline constexpr const AddressType getAddress() {
 			return address;
@@ -98,46 +408,217 @@ namespace Register {
 
 		static inline const void set(const typename Descr::FieldValueType value) {
 			static_assert(true, "Don't read register, write register as single field");
-			const typename Descr::RegisterValueType valueToWrite = (static_cast<const typename Descr::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
-			*reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() ) = valueToWrite;
-			postWrite();
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), valueToWrite, Descr::getBitMask() );
 		}
 
 	};
 
-	template<AddressType address, typename Descr>
-	struct RO {
+	template<AddressType address, typename Descr, typename Owner = Description<address> >
+	struct RO : public FieldType< typename Descr::FieldValueType > {
 		static constexpr const AccessMode Policy = AccessMode::ReadOnly;
 		typedef Descr Description;
-		typedef typename Descr::FieldValueType Type;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
+
+		static inline constexpr const AddressType getAddress() {
+			return address;
+		}
+
+		static inline const typename Descr::FieldValueType get() {
+			const typename Owner::RegisterValueType regValue = ioRead<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask() );
+			return static_cast<const typename Descr::FieldValueType>( ( regValue >> Descr::getLsb() ) & Descr::getLsbMask() );
+		}
+	};
+
+	/* Store to set and clear alias registers. Single bit field is updated by one store */
+	template< typename Owner, typename Descr >
+	inline void writeSetClear( const AddressType setAddress, const AddressType clearAddress, const typename Owner::RegisterValueType bits ) {
+		if constexpr ( Descr::getBitCount() == 1 ) {
+			if ( 0 != bits ) {
+				ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( setAddress, Descr::getBitMask(), Descr::getBitMask() );
+			} else {
+				ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( clearAddress, Descr::getBitMask(), Descr::getBitMask() );
+			}
+		} else {
+			ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( setAddress, bits, Descr::getBitMask() );
+			ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( clearAddress, ~bits & Descr::getBitMask(), Descr::getBitMask() );
+		}
+	}
+
+	template< typename Field >
+	constexpr const typename Field::RegisterDescription::RegisterValueType getFieldWriteMaskInt();
+
+	/*
+		Write one to clear (W1C) and write one to set (W1S) fields. Zero bits of store are ignored by
+		these bits, so other W1C/W1S fields of register are written as 0 and are not touched.
+		set() needs to know other bits of register, so field is declared with its register type
+			typedef W1C< getAddress(), Bit<1>, IrqStatus > Done;
+		and W1C/W1S fields are listed by WriteOneFields of register. set() is a single store of field bits,
+		when register has no RW bits, otherwise it is RMW of RW bits (write-one bits are never written back).
+		Field without register type is written by Register::Write< IrqStatus, IrqStatus::Done >.
+	*/
+	template< AddressType address, typename Descr, AccessMode mode, typename Owner = Description<address> >
+	struct WriteOne : public FieldType< typename Descr::FieldValueType > {
+		static_assert( ( AccessMode::WriteOneToClear == mode ) || ( AccessMode::WriteOneToSet == mode ), "Please check access mode" );
+		static constexpr const AccessMode Policy = mode;
+		typedef Descr Description;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
+
+		static inline constexpr const AddressType getAddress() {
+			return address;
+		}
+
+		static inline const void set(const typename Descr::FieldValueType value) {
+			constexpr const typename Owner::RegisterValueType WriteMask = getFieldWriteMaskInt< WriteOne >();
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			if constexpr ( WriteMask == Owner::Value::Description::getBitMask() ) {
+				ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), valueToWrite, Descr::getBitMask() );
+			} else {
+				ioModify<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), WriteMask, valueToWrite );
+			}
+		}
+
+		static inline const typename Descr::FieldValueType get() {
+			const typename Owner::RegisterValueType regValue = ioRead<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask() );
+			return static_cast<const typename Descr::FieldValueType>( ( regValue >> Descr::getLsb() ) & Descr::getLsbMask() );
+		}
+	};
+
+	template< AddressType address, typename Descr, typename Owner = Description<address> >
+	using W1C = WriteOne< address, Descr, AccessMode::WriteOneToClear, Owner >;
+
+	template< AddressType address, typename Descr, typename Owner = Description<address> >
+	using W1S = WriteOne< address, Descr, AccessMode::WriteOneToSet, Owner >;
+
+	/*
+		Read to clear field, it can't be written. Any read of register clears it, RMW of other fields too,
+		so register is declared with IoDescription of Rmw::Forbidden policy ( Mem32IoReadClearDescription ),
+		or Rmw::ClearsReadToClear<>, when RMW may lose pending RC bits.
+	*/
+	template< AddressType address, typename Descr, typename Owner = Description<address> >
+	struct RC : public FieldType< typename Descr::FieldValueType > {
+		static_assert( Rmw::ReadToClearSafe< typename Rmw::PolicyOf< typename Owner::IoDescription >::type >::value, "RMW of register clears RC field, please declare register with Rmw::Forbidden policy (Mem32IoReadClearDescription) or Rmw::ClearsReadToClear<>" );
+		static constexpr const AccessMode Policy = AccessMode::ReadToClear;
+		typedef Descr Description;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
+
+		static inline constexpr const AddressType getAddress() {
+			return address;
+		}
+
+		static inline const typename Descr::FieldValueType get() {
+			const typename Owner::RegisterValueType regValue = ioRead<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask() );
+			return static_cast<const typename Descr::FieldValueType>( ( regValue >> Descr::getLsb() ) & Descr::getLsbMask() );
+		}
+	};
+
+	/*
+		Field of register with SET and CLR alias registers (at setOffset and clearOffset from register).
+		Field is read from register itself, and written without read: 1 bits to SET alias, 0 bits to CLR alias.
+	*/
+	template< AddressType address, typename Descr, AddressType setOffset, AddressType clearOffset, typename Owner = Description<address> >
+	struct SC : public FieldType< typename Descr::FieldValueType > {
+		static constexpr const AccessMode Policy = AccessMode::SetClear;
+		typedef Descr Description;
+		typedef typename Owner::Io Io;
+		typedef Owner RegisterDescription;
 
 		static inline constexpr const AddressType getAddress() {
 			return address;
 		}
 
+		static inline constexpr const AddressType getSetOffset() { return setOffset; }
+		static inline constexpr const AddressType getClearOffset() { return clearOffset; }
+
+		static inline const void set(const typename Descr::FieldValueType value) {
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			writeSetClear<Owner, Descr>( getAddress() + setOffset, getAddress() + clearOffset, valueToWrite );
+		}
+
 		static inline const typename Descr::FieldValueType get() {
-			preRead();
-			const typename Descr::RegisterValueType regValue = *reinterpret_cast<volatile typename Descr::RegisterValueType* const>( getAddress() );
+			const typename Owner::RegisterValueType regValue = ioRead<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( getAddress(), Descr::getBitMask() );
 			return static_cast<const typename Descr::FieldValueType>( ( regValue >> Descr::getLsb() ) & Descr::getLsbMask() );
 		}
 	};
 
 	struct RS_Null {};
 
-	template<AddressType address, typename Descr, typename Next = RS_Null>
-	struct RS {
-		typedef Next NextRS;
+	template<AddressType address, typename... Descrs>
+	struct RS;
+
+	template<typename Descr>
+	struct isReservedSet : std::false_type {};
+
+	template<AddressType address, typename... Descrs>
+	struct isReservedSet< RS<address, Descrs...> > : std::true_type {};
+
+	/*
+		Reserved bits of register, flat list of bit descriptions:
+			typedef RS< getAddress(), Field< 27, 27 >, Bit< 29 >, Field< 31, 31 > > Reserved;
+		Register without reserved bits declares RS< getAddress() >.
+		Nested list RS< getAddress(), Field< 27, 27 >, RS< getAddress(), Field< 31, 31 > > > is accepted too.
+	*/
+	template<AddressType address, typename... Descrs>
+	struct RS : public FieldType< DefaultValueType > {
 		static constexpr const AccessMode Policy = AccessMode::Reserved;
-		static constexpr const typename Descr::FieldValueType DefaultValue = 0;
-		typedef Descr Description;
-		typedef typename Descr::FieldValueType Type;
+		static constexpr const DefaultValueType DefaultValue = 0;
 		static inline constexpr const AddressType getAddress() {
 			return address;
 		}
+
+		template<typename ValueType>
+		static constexpr const ValueType getMask() {
+			return ( static_cast<ValueType>( 0 ) | ... | getPartMask< ValueType, Descrs >() );
+		}
+
+	private:
+		template<typename ValueType, typename Descr>
+		static constexpr const ValueType getPartMask() {
+			if constexpr ( std::is_same< Descr, RS_Null >::value == true ) {
+				return 0;
+			} else if constexpr ( isReservedSet< Descr >::value == true ) {
+				static_assert( ( address == Descr::getAddress() ), "Please check reserved field address" );
+				return Descr::template getMask< ValueType >();
+			} else {
+				return static_cast<ValueType>( Descr::getBitMask() );
+			}
+		}
 	};
 
-	template<AddressType address, typename RegValueType = DefaultValueType>
-	struct Description {
+	/*
+		Register description. Field accessors declared inside of derived description
+		(RW, RO, WO, RS, W1C, W1S, RC, SC) are bound to the register access backend "Io".
+	*/
+	template<AddressType address, typename RegValueType, typename IoArg, typename IoDescriptionArg>
+	struct Description : public RegisterTypes< RegValueType, IoArg, IoDescriptionArg > {
+		static_assert( std::is_same< RegValueType, typename IoDescriptionArg::RegDataType >::value, "Please check register value type and IoDescription" );
+
+		/* Is register value changed by hardware (status register)? Redefine it in derived description */
+		static constexpr const bool HardwareUpdated = false;
+
+		/* Is register sequence counter of hardware, odd while update is in progress (seqlock, see ConsistentRead)? */
+		static constexpr const bool SequenceCounter = false;
+
+		template<AddressType fieldAddress, typename Descr>
+		using RW = Register::RW<fieldAddress, Descr, Description>;
+		template<AddressType fieldAddress, typename Descr>
+		using RO = Register::RO<fieldAddress, Descr, Description>;
+		template<AddressType fieldAddress, typename Descr>
+		using WO = Register::WO<fieldAddress, Descr, Description>;
+		template<AddressType fieldAddress, typename... Descrs>
+		using RS = Register::RS<fieldAddress, Descrs...>;
+		template<AddressType fieldAddress, typename Descr, typename Reg = Description>
+		using W1C = Register::W1C<fieldAddress, Descr, Reg>;
+		template<AddressType fieldAddress, typename Descr, typename Reg = Description>
+		using W1S = Register::W1S<fieldAddress, Descr, Reg>;
+		template<AddressType fieldAddress, typename Descr>
+		using RC = Register::RC<fieldAddress, Descr, Description>;
+		template<AddressType fieldAddress, typename Descr, AddressType setOffset, AddressType clearOffset>
+		using SC = Register::SC<fieldAddress, Descr, setOffset, clearOffset, Description>;
+
 		static constexpr const AddressType getAddress() {
 			return _address;
 		}
@@ -152,13 +633,8 @@ namespace Register {
 			return 0;
 		} else {
 			static_assert( ( Reg::Value::getAddress() == Field::getAddress() ), "Please check filed parameter and register" );
-			if constexpr ( std::is_same<typename Field::NextRS, RS_Null>::value == true ) { 
-				return Field::Description::getBitMask();
-			} else {
-				return getRegReservedMaskInt<Reg, typename Field::NextRS >() | Field::Description::getBitMask();
-			}
+			return Field::template getMask< typename Reg::Value::Type >();
 		}
-		return 0;
 	}
 
 	template <typename Reg>
@@ -166,151 +642,1304 @@ namespace Register {
 		return getRegReservedMaskInt<Reg, typename Reg::Reserved>();
 	};
 
-	// C++17, it is possible to use this one
-	// But, I am really wanna to check address
-	//template <typename Reg, typename... Fields>
-	//constexpr typename Reg::Value::Type getRegMaskInt() {
-	//	return 	(Fields::Description::getBitMask() | ...);	
-	//}
+	/* Field has one of access modes */
+	template< typename Field, AccessMode... modes >
+	constexpr const bool hasPolicy() {
+		return ( ( Field::Policy == modes ) || ... );
+	}
 
-	template <typename Reg, typename Field, typename... Fields>
-	constexpr typename Reg::Value::Type getRegMaskInt() {		
-		static_assert( ( Reg::Value::getAddress() == Field::getAddress() ), "Please check filed parameter and register" );
-		if constexpr ( sizeof...(Fields) == 0 ) {
-			if constexpr ( AccessMode::Reserved == Field::Policy ) {
-				return getRegReservedMaskInt<Reg, Field>();
+	/*
+		Set of register fields, declared by register description:
+		W1C/W1S fields of register (field write needs them, RW bits of register are kept by RMW)
+			typedef FieldSet< IrqStatus::Done, IrqStatus::Error > WriteOneFields;
+		Register writes store 0 to omitted ones (no effect), and never write back read value of them.
+		RO/RC fields of register (they are skipped by Register::Context)
+			typedef FieldSet< DmaStatus::Busy, DmaStatus::Level > ReadOnlyFields;
+	*/
+	template< typename... FieldArgs >
+	struct FieldSet {
+		template< typename Reg >
+		static constexpr const typename Reg::Value::Type getMask() {
+			static_assert( ( ( Reg::getAddress() == FieldArgs::getAddress() ) && ... ), "Please check field parameter and register" );
+			return ( static_cast<typename Reg::Value::Type>( 0 ) | ... | FieldArgs::Description::getBitMask() );
+		}
+
+		template< AccessMode... modes >
+		static constexpr const bool isOneOf() {
+			return ( hasPolicy< FieldArgs, modes... >() && ... );
+		}
+	};
+
+	template< typename Reg, typename = void >
+	struct hasWriteOneFields : std::false_type {};
+
+	template< typename Reg >
+	struct hasWriteOneFields< Reg, std::void_t< typename Reg::WriteOneFields > > : std::true_type {};
+
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getRegWriteOneMaskInt() {
+		if constexpr ( hasWriteOneFields<Reg>::value ) {
+			static_assert( Reg::WriteOneFields::template isOneOf< AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >(), "Only W1C and W1S fields are write-one fields" );
+			return Reg::WriteOneFields::template getMask<Reg>();
+		} else {
+			return 0;
+		}
+	}
+
+	template< typename Reg, typename = void >
+	struct hasReadOnlyFields : std::false_type {};
+
+	template< typename Reg >
+	struct hasReadOnlyFields< Reg, std::void_t< typename Reg::ReadOnlyFields > > : std::true_type {};
+
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getRegReadOnlyMaskInt() {
+		if constexpr ( hasReadOnlyFields<Reg>::value ) {
+			static_assert( Reg::ReadOnlyFields::template isOneOf< AccessMode::ReadOnly, AccessMode::ReadToClear >(), "Only RO and RC fields are read-only fields" );
+			return Reg::ReadOnlyFields::template getMask<Reg>();
+		} else {
+			return 0;
+		}
+	}
+
+	/*
+		Bits, which may be written as 0 by any register write: reserved and write-one bits. They are never read back by RMW.
+		Register with RC fields (Rmw::Forbidden) has no RMW, its RO/RC bits ( ReadOnlyFields ) ignore stores, so they are written as 0 too.
+	*/
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getRegWriteNeutralMaskInt() {
+		return getRegReservedMaskInt< Reg >() | getRegWriteOneMaskInt< Reg >() | ( isRmwForbidden< Reg >() ? getRegReadOnlyMaskInt< Reg >() : 0 );
+	}
+
+	/* Bits, which are saved and restored by Register::Context: reserved, read-only and write-one bits are skipped */
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getRegRestoreMaskInt() {
+		return Reg::Value::Description::getBitMask() & ~( getRegWriteNeutralMaskInt< Reg >() | getRegReadOnlyMaskInt< Reg >() );
+	}
+
+	/* Fields may be written by register write */
+	template< typename... Fields >
+	constexpr const bool isWritable() {
+		return ( ( ( Fields::Policy != AccessMode::ReadOnly ) && ( Fields::Policy != AccessMode::ReadToClear ) ) && ... );
+	}
+
+	/* Bits of reserved field in register value: RS default value is 0 */
+	template< typename Reserved >
+	struct ReservedBits {
+		static constexpr const uint64_t getBitMask() { return Reserved::template getMask< uint64_t >(); }
+		static constexpr const DefaultValueType getLsbMask() { return 0; }
+		static constexpr const size_t getLsb() { return 0; }
+	};
+
+	/*
+		Bit description of field ( Field< msb, lsb > ). Fields of different registers share it,
+		so masks and value helpers are folded per bit layout, without helper instantiated per field of each register.
+	*/
+	template< typename Field, bool reserved = ( Field::Policy == AccessMode::Reserved ) >
+	struct FieldBitsOf {
+		typedef typename Field::Description type;
+	};
+
+	template< typename Field >
+	struct FieldBitsOf< Field, true > {
+		typedef ReservedBits< Field > type;
+	};
+
+	/* W1C/W1S field is listed by WriteOneFields, so register write doesn't write back other pending write-one bits */
+	template< typename Reg, typename Field >
+	constexpr const bool isWriteOneFieldListed() {
+		if constexpr ( hasPolicy< Field, AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >() ) {
+			return ( getRegWriteOneMaskInt< Reg >() & Field::Description::getBitMask() ) == Field::Description::getBitMask();
+		} else {
+			return true;
+		}
+	}
+
+	template< typename Reg, typename... Fields >
+	constexpr const bool isWriteOneListed() {
+		constexpr const typename Reg::Value::Type WriteOneMask = getRegWriteOneMaskInt< Reg >();
+		return ( ( ( ( Fields::Policy != AccessMode::WriteOneToClear ) && ( Fields::Policy != AccessMode::WriteOneToSet ) ) ||
+			( ( WriteOneMask & FieldBitsOf< Fields >::type::getBitMask() ) == FieldBitsOf< Fields >::type::getBitMask() ) ) && ... );
+	}
+
+	/* Field is declared with its register type, not only by base Description (other bits of register are known) */
+	template< typename Reg >
+	constexpr const bool isRegisterKnown() {
+		return !std::is_same< Reg, Description< Reg::getAddress(), typename Reg::RegisterValueType, typename Reg::Io, typename Reg::IoDescription > >::value;
+	}
+
+	/* Bits of register, which are replaced by field write. W1C/W1S field replaces write-one and reserved bits too */
+	template< typename Field >
+	constexpr const typename Field::RegisterDescription::RegisterValueType getFieldWriteMaskInt() {
+		typedef typename Field::RegisterDescription Reg;
+		if constexpr ( hasPolicy< Field, AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >() ) {
+			static_assert( isRegisterKnown< Reg >(), "W1C/W1S field doesn't know RW bits of register, please declare it as W1C< getAddress(), Field, Register > or write it by Register::Write< Register, Field >" );
+			if constexpr ( isRegisterKnown< Reg >() ) {
+				static_assert( isWriteOneFieldListed< Reg, Field >(), "Please list W1C/W1S field in WriteOneFields of register" );
+				return getRegWriteNeutralMaskInt< Reg >() | Field::Description::getBitMask();
 			} else {
 				return Field::Description::getBitMask();
 			}
 		} else {
-			if constexpr ( AccessMode::Reserved == Field::Policy ) {
-				return getRegReservedMaskInt<Reg, Field>() | getRegMaskInt<Reg, Fields...>();
-			} else {
-				return Field::Description::getBitMask() | getRegMaskInt<Reg, Fields...>();
-			}
+			return Field::Description::getBitMask();
 		}
 	}
 
-	template <typename Reg, typename Field, typename... Fields>
-	inline const typename Reg::Value::Type getRegValueInt( const typename Field::Type val, const typename Fields::Type... args ) {
-		static_assert( ( Reg::Value::getAddress() == Field::getAddress() ), "Please check field parameter and register" );
+	/* All fields are written through SET/CLR aliases */
+	template< typename... Fields >
+	constexpr const bool isSetClear() {
+		return ( sizeof...(Fields) != 0 ) && ( ( Fields::Policy == AccessMode::SetClear ) && ... );
+	}
+
+	/* Field is written by a single store of its bits, without read */
+	template< typename Field >
+	constexpr const bool isSingleStore() {
+		return ( Field::Policy == AccessMode::WriteOnly ) || ( Field::Description::getBitCount() == ( sizeof( typename Field::RegisterDescription::RegisterValueType ) * 8) ) ||
+			( hasPolicy< Field, AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >() && ( getFieldWriteMaskInt< Field >() == Field::RegisterDescription::Value::Description::getBitMask() ) );
+	}
+
+	template <typename ValueType, typename Bits>
+	constexpr const ValueType getBitsValueInt( const ValueType val ) {
+		return ( val & static_cast<ValueType>( Bits::getLsbMask() ) ) << Bits::getLsb();
+	}
+
+	/*
+		Masks and values are folded over flat field list, so large register maps don't instantiate recursive chains.
+		Packs of field values are passed without top-level const ( "typename Fields::Type... args" ): each field
+		typedef is a variant of the same integer type, and GCC looks up const variant through all of them,
+		so const field parameters make compile time quadratic in number of fields of register map.
+	*/
+	template <typename Reg, typename... Fields>
+	constexpr typename Reg::Value::Type getRegMaskInt() {
+		static_assert( ( ( Reg::Value::getAddress() == Fields::getAddress() ) && ... ), "Please check filed parameter and register" );
+		return ( static_cast<typename Reg::Value::Type>( 0 ) | ... | static_cast<typename Reg::Value::Type>( FieldBitsOf< Fields >::type::getBitMask() ) );
+	}
+
+	template <typename Reg, typename... Fields>
+	constexpr const typename Reg::Value::Type getRegValueInt( typename Fields::Type... args ) {
+		static_assert( ( ( Reg::Value::getAddress() == Fields::getAddress() ) && ... ), "Please check field parameter and register" );
+		return ( static_cast<typename Reg::Value::Type>( 0 ) | ... | getBitsValueInt< typename Reg::Value::Type, typename FieldBitsOf< Fields >::type >( static_cast<typename Reg::Value::Type>( args ) ) );
+	}
+
+	/*
+		Report of write call sites, which fall back to read-modify-write.
+		Build with REGISTER_REPORT_RMW defined: each such call site is reported by compiler warning
+		(with instantiation context), -Werror=deprecated-declarations makes it an error.
+	*/
+#if defined(REGISTER_REPORT_RMW)
+	template< typename Reg >
+	[[deprecated("Register write falls back to read-modify-write (RMW), please write all fields or use WriteFromReset")]]
+	constexpr void reportRmw() {}
+#else
+	template< typename Reg >
+	constexpr void reportRmw() {}
+#endif
+
+	/* Fields of register with SET/CLR aliases are written without read */
+	template< typename Reg, typename Field, typename... Fields >
+	inline void writeSetClearFields( const AddressType address, const typename Field::Type arg, typename Fields::Type... args ) {
+		static_assert( ( ( ( Field::getSetOffset() == Fields::getSetOffset() ) && ( Field::getClearOffset() == Fields::getClearOffset() ) ) && ... ), "Fields have different SET/CLR aliases" );
 		if constexpr ( sizeof...(Fields) == 0 ) {
-			if constexpr ( Field::Policy == AccessMode::Reserved ) {
-				return Field::DefaultValue;
-			} else {
-				const typename Reg::Value::Type regValue = (static_cast<typename Reg::Value::Type>(val) & Field::Description::getLsbMask() ) << Field::Description::getLsb();
-				return regValue;
-			}
+			const typename Reg::Value::Type valueToWrite = getRegValueInt<Reg, Field>( arg );
+			writeSetClear<Reg, typename Field::Description>( address + Field::getSetOffset(), address + Field::getClearOffset(), valueToWrite );
 		} else {
-			if constexpr ( Field::Policy == AccessMode::Reserved ) {
-				return Field::DefaultValue | getRegValueInt<Reg, Fields...>( args... );
-			} else {
-				const typename Reg::Value::Type regValue = (static_cast<typename Reg::Value::Type>(val) & Field::Description::getLsbMask() ) << Field::Description::getLsb();
-				return regValue | getRegValueInt<Reg, Fields...>( args... );
-			}
+			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Field, Fields...>();
+			const typename Reg::Value::Type valueToWrite = getRegValueInt<Reg, Field, Fields...>( arg, args... );
+			ioWrite<IoOwnerOf< Reg >, typename Reg::Value::Type>( address + Field::getSetOffset(), valueToWrite, ConcatMask );
+			ioWrite<IoOwnerOf< Reg >, typename Reg::Value::Type>( address + Field::getClearOffset(), ~valueToWrite & ConcatMask, ConcatMask );
 		}
 	}
 
 	template< typename Reg, typename... Fields >
-	inline void Write( const typename Fields::Type... args )  {
-		constexpr const typename Reg::Value::Type ReservedMask = getRegReservedMaskInt< Reg >();
-		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | ReservedMask;
+	inline void Write( typename Fields::Type... args )  {
+		static_assert( isWritable< Fields... >(), "Field is not writable" );
+		static_assert( isWriteOneListed< Reg, Fields... >(), "Please list W1C/W1S field in WriteOneFields of register" );
+		constexpr const typename Reg::Value::Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | NeutralMask;
+		constexpr const WriteLane Lane = getWriteLane< IoOwnerOf< Reg >, typename Reg::Value::Type >( getRegMaskInt< Reg, Fields...>(), ConcatMask );
 		if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
-			typename Reg::Value::Type regValue = getRegValueInt<Reg, Fields...>( args... );
-			Reg::Value::set(regValue);
+			ioWrite<IoOwnerOf< Reg >, typename Reg::Value::Type>( Reg::getAddress(), getRegValueInt<Reg, Fields...>( args... ) );
+		} else if constexpr ( isSetClear< Fields... >() ) {
+			writeSetClearFields<Reg, Fields...>( Reg::getAddress(), args... );
+		} else if constexpr ( 0 != Lane.size ) {
+			ioWriteLane<IoOwnerOf< Reg >, typename Reg::Value::Type, Lane.size, Lane.offset>( Reg::getAddress(), getRegValueInt<Reg, Fields...>( args... ), ConcatMask );
+		} else {
+			reportRmw<Reg>();
+			ioModify<IoOwnerOf< Reg >, typename Reg::Value::Type>( Reg::getAddress(), ConcatMask, getRegValueInt<Reg, Fields...>( args... ) );
+		}
+	};
+
+	/*
+		Register reset value and field defaults.
+		Description may declare datasheet reset value of register:
+			static constexpr const Type ResetValue = 0x...;
+		and defaults of fields (they override reset value):
+			typedef Defaults< Default< VcoOutPowerDown, TVcoOutputPowerDown::Normal > > FieldDefaults;
+	*/
+	template< typename FieldArg, auto value >
+	struct Default {
+		typedef FieldArg Field;
+		static constexpr const typename FieldArg::Type DefaultValue = value;
+	};
+
+	template< typename... DefaultArgs >
+	struct Defaults {
+		template< typename Reg >
+		static constexpr const typename Reg::Value::Type getMask() {
+			return ( static_cast<typename Reg::Value::Type>( 0 ) | ... | DefaultArgs::Field::Description::getBitMask() );
+		}
+
+		template< typename Reg >
+		static constexpr const typename Reg::Value::Type getValue() {
+			return ( static_cast<typename Reg::Value::Type>( 0 ) | ... |
+				( ( static_cast<typename Reg::Value::Type>( DefaultArgs::DefaultValue ) & DefaultArgs::Field::Description::getLsbMask() ) << DefaultArgs::Field::Description::getLsb() ) );
+		}
+	};
+
+	template< typename Reg, typename = void >
+	struct hasResetValue : std::false_type {};
+
+	template< typename Reg >
+	struct hasResetValue< Reg, std::void_t< decltype( Reg::ResetValue ) > > : std::true_type {};
+
+	template< typename Reg, typename = void >
+	struct hasFieldDefaults : std::false_type {};
+
+	template< typename Reg >
+	struct hasFieldDefaults< Reg, std::void_t< typename Reg::FieldDefaults > > : std::true_type {};
+
+	/* Bits of register, which value after reset is known */
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getResetKnownMaskInt() {
+		if constexpr ( hasResetValue<Reg>::value ) {
+			return Reg::Value::Description::getBitMask();
+		} else if constexpr ( hasFieldDefaults<Reg>::value ) {
+			return Reg::FieldDefaults::template getMask<Reg>();
 		} else {
-			typename Reg::Value::Type regValue = Reg::Value::get();
-			regValue &= ~( ConcatMask );
-			regValue |= getRegValueInt<Reg, Fields...>( args... );
-			Reg::Value::set(regValue);
+			return 0;
+		}
+	}
+
+	/* Register value after reset, field defaults are applied */
+	template< typename Reg >
+	constexpr const typename Reg::Value::Type getResetValueInt() {
+		typename Reg::Value::Type value = 0;
+		if constexpr ( hasResetValue<Reg>::value ) {
+			value = static_cast<typename Reg::Value::Type>( Reg::ResetValue );
+		}
+		if constexpr ( hasFieldDefaults<Reg>::value ) {
+			value &= ~( Reg::FieldDefaults::template getMask<Reg>() );
+			value |= Reg::FieldDefaults::template getValue<Reg>();
 		}
+		return value;
+	}
+
+	/* Write fields, omitted fields are composed from reset value and defaults at compile time. Always a single store */
+	template< typename Reg, typename... Fields >
+	inline void WriteFromReset( typename Fields::Type... args )  {
+		static_assert( isWritable< Fields... >(), "Field is not writable" );
+		constexpr const typename Reg::Value::Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+		constexpr const typename Reg::Value::Type FieldsMask = getRegMaskInt< Reg, Fields...>();
+		static_assert( ( ( FieldsMask | NeutralMask | getResetKnownMaskInt< Reg >() ) == Reg::Value::Description::getBitMask() ),
+			"Value of omitted fields is unknown, please describe ResetValue or FieldDefaults of register" );
+		constexpr const typename Reg::Value::Type ResetPart = getResetValueInt< Reg >() & ~( FieldsMask | getRegWriteOneMaskInt< Reg >() );
+		Reg::Value::set( ResetPart | getRegValueInt<Reg, Fields...>( args... ) );
 	};
 
 	template< typename Reg, typename... Fields >
-	inline bool IsEqual( const typename Fields::Type... args )  {
+	inline bool IsEqual( typename Fields::Type... args )  {
 		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>();
 		const typename Reg::Value::Type maskedValue = getRegValueInt<Reg, Fields...>( args... ) & ConcatMask;
 		const typename Reg::Value::Type maskedReadValue = Reg::Value::get() & ConcatMask;
 		return ( maskedValue == maskedReadValue );
 	};
 
-	template<typename Reg, typename Field, typename... Fields>
-	inline void getFieldsFromReg(const typename Reg::Value::Type regValue, typename Field::Type &arg, typename Fields::Type&... args) {
-		static_assert( ( Reg::Value::getAddress() == Field::getAddress() ), "Please check field parameter and register" );
-		static_assert(( Field::Policy != AccessMode::Reserved ), "Trying to read reserved field");
-		arg = static_cast<const typename Field::Type>( ( regValue >> Field::Description::getLsb() ) & Field::Description::getLsbMask() );
-		if constexpr ( sizeof...(Fields) != 0 ) {
-			getFieldsFromReg<Reg, Fields...>( regValue, args... );
-		}		
+	/*
+		Bus access cost of register operation, computed at compile time from masks and IoDescription.
+		It is a model of access path selection (i.e. RMW read of omitted fields):
+		static_assert( Register::getWriteCost< PllConfig1, ... >().reads == 0, "..." );
+		Generated code itself is checked by bench/codegen ( loads, stores, barriers, instructions ).
+	*/
+	struct AccessCost {
+		size_t reads;
+		size_t writes;
+		size_t barriers;
+	};
+
+	template< typename Owner >
+	constexpr const AccessCost getBusReadCost() {
+		return AccessCost { 1, 0, Owner::IoDescription::Access::Read::Sync::cpu ? 1u : 0u };
 	}
 
-	template<typename Reg, typename ...Fields>
-	inline void Read( typename Fields::Type&... args ) {
-		const typename Reg::Value::Type regValue = Reg::Value::get();
-		getFieldsFromReg<Reg, Fields...>( regValue, args... );
+	template< typename Owner >
+	constexpr const AccessCost getBusWriteCost() {
+		return AccessCost { 0, 1, Owner::IoDescription::Access::Write::Sync::cpu ? 1u : 0u };
 	}
 
-	template< typename Reg >
-	struct Class {
-		typedef Reg Description;
-		Class() : _address( Reg::getAddress())  {};
-		Class( AddressType address ) : _address(address) {};
+	constexpr const AccessCost operator+( const AccessCost a, const AccessCost b ) {
+		return AccessCost { a.reads + b.reads, a.writes + b.writes, a.barriers + b.barriers };
+	}
 
-		template <typename... Fields>
-		inline void Write( const typename Fields::Type... args ){
-			constexpr const typename Reg::Value::Type ReservedMask = getRegReservedMaskInt< Reg >();
-			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | ReservedMask;
-			if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
-				typename Reg::Value::Type regValue = getRegValueInt<Reg, Fields...>( args... );
-				*reinterpret_cast<volatile typename Reg::Value::Type* const>(_address) = regValue;
-				postWrite();
+	/* Cost of Register::Write<Reg, Fields...> */
+	template< typename Reg, typename Field, typename... Fields >
+	constexpr const AccessCost getWriteCost() {
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Field, Fields...>() | getRegWriteNeutralMaskInt< Reg >();
+		if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
+			return getBusWriteCost<Reg>();
+		} else if constexpr ( isSetClear< Field, Fields... >() ) {
+			if constexpr ( ( sizeof...(Fields) == 0 ) && ( Field::Description::getBitCount() == 1 ) ) {
+				return getBusWriteCost<Reg>();
 			} else {
-				preRead();
-				typename Reg::Value::Type regValue = *reinterpret_cast<volatile typename Reg::Value::Type* const>(_address);
+				return getBusWriteCost<Reg>() + getBusWriteCost<Reg>();
+			}
+		} else if constexpr ( 0 != getWriteLane< IoOwnerOf< Reg >, typename Reg::Value::Type >( getRegMaskInt< Reg, Field, Fields...>(), ConcatMask ).size ) {
+			return getBusWriteCost<Reg>();
+		} else {
+			return getBusReadCost<Reg>() + getBusWriteCost<Reg>();
+		}
+	}
+
+	/* Cost of Register::WriteFromReset<Reg, Fields...> */
+	template< typename Reg, typename... Fields >
+	constexpr const AccessCost getWriteFromResetCost() {
+		return getBusWriteCost<Reg>();
+	}
+
+	/* Cost of Field::set() */
+	template< typename Field >
+	constexpr const AccessCost getSetCost() {
+		typedef typename Field::Description Descr;
+		typedef typename Field::RegisterDescription Owner;
+		if constexpr ( isSingleStore< Field >() ) {
+			return getBusWriteCost<Owner>();
+		} else if constexpr ( Field::Policy == AccessMode::SetClear ) {
+			return ( Descr::getBitCount() == 1 ) ? getBusWriteCost<Owner>() : ( getBusWriteCost<Owner>() + getBusWriteCost<Owner>() );
+		} else if constexpr ( 0 != getWriteLane< IoOwnerOf< Owner >, typename Owner::RegisterValueType >( Descr::getBitMask(), Descr::getBitMask() ).size ) {
+			return getBusWriteCost<Owner>();
+		} else {
+			return getBusReadCost<Owner>() + getBusWriteCost<Owner>();
+		}
+	}
+
+	/* Cost of Register::IsEqual<Reg, Fields...>, Register::Read<Reg, Fields...> and Field::get() */
+	template< typename Reg, typename... Fields >
+	constexpr const AccessCost getIsEqualCost() {
+		return getBusReadCost<Reg>();
+	}
+
+	template<typename Reg, typename... Fields>
+	inline void getFieldsFromReg(const typename Reg::Value::Type regValue, typename Fields::Type&... args) {
+		static_assert( ( ( Reg::Value::getAddress() == Fields::getAddress() ) && ... ), "Please check field parameter and register" );
+		static_assert( ( ( Fields::Policy != AccessMode::Reserved ) && ... ), "Trying to read reserved field");
+		( ( args = static_cast<typename Fields::Type>( ( regValue >> Fields::Description::getLsb() ) & Fields::Description::getLsbMask() ) ), ... );
+	}
+
+	template<typename Reg, typename ...Fields>
+	inline void Read( typename Fields::Type&... args ) {
+		const typename Reg::Value::Type regValue = ioRead<IoOwnerOf< Reg >, typename Reg::Value::Type>( Reg::getAddress() );
+		getFieldsFromReg<Reg, Fields...>( regValue, args... );
+	}
+
+	/*
+		Staged register update: fields are accumulated in RAM, and flushed by a single store.
+		Fields added by With<Field>() are tracked at compile time (new staged type is returned),
+		fields added by Set<Field>() are tracked at run time.
+		Flush() does at most one read and one write. The read is skipped, when staged fields
+		and reserved fields cover whole register.
+
+		auto staged = Register::Staged<PllConfig1>().With<PllConfig1::Bypass>( PllConfig1::Bypass::Type::Bypass );
+		configureDividers( staged ); // staged.Set<PllConfig1::FBdiv>(...)
+		staged.Flush();
+	*/
+	template< typename Reg, typename... Fields >
+	class Staged {
+	public:
+		typedef Reg Description;
+		typedef typename Reg::Value::Type Type;
+
+		Staged() {};
+
+		template< typename Field >
+		inline Staged< Reg, Fields..., Field > With( const typename Field::Type value ) const {
+			return Staged< Reg, Fields..., Field >( merge<Field>( _value, value ), _mask | Field::Description::getBitMask() );
+		}
+
+		template< typename Field >
+		inline Staged& Set( const typename Field::Type value ) {
+			_value = merge<Field>( _value, value );
+			_mask |= Field::Description::getBitMask();
+			return *this;
+		}
+
+		inline void Flush() {
+			constexpr const Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+			constexpr const Type StaticMask = getStagedMask() | NeutralMask;
+			constexpr const Type FullMask = Reg::Value::Description::getBitMask();
+			if constexpr ( StaticMask == FullMask ) {
+				Reg::Value::set( _value );
+			} else {
+				if ( ( _mask | StaticMask ) == FullMask ) {
+					Reg::Value::set( _value );
+				} else {
+					ioModify<IoOwnerOf< Reg >, Type>( Reg::getAddress(), _mask | NeutralMask, _value );
+				}
+			}
+		}
+
+		inline const Type getValue() const { return _value; }
+		inline const Type getMask() const { return _mask; }
+
+	private:
+		template< typename, typename... > friend class Staged;
+
+		Staged( const Type value, const Type mask ) : _value( value ), _mask( mask ) {};
+
+		static constexpr const Type getStagedMask() {
+			if constexpr ( sizeof...(Fields) == 0 ) {
+				return 0;
+			} else {
+				return getRegMaskInt< Reg, Fields... >();
+			}
+		}
+
+		template< typename Field >
+		static inline const Type merge( const Type regValue, const typename Field::Type value ) {
+			static_assert( ( Reg::getAddress() == Field::getAddress() ), "Please check bitfiled name and resgister");
+			static_assert( ( Field::Policy == AccessMode::ReadWrite ) || ( Field::Policy == AccessMode::WriteOnly ), "Field is not writable" );
+			return ( regValue & ~( Field::Description::getBitMask() ) ) | getRegValueInt< Reg, Field >( value );
+		}
+
+	private:
+		Type _value { 0 };
+		Type _mask { 0 };
+	};
+
+	/*
+		Shadowed register: RAM copy of register, which value is changed by software only.
+		Partial write merges fields into the shadow copy and issues a single store, without bus read.
+		The first partial write reads the register once, Sync() reads it again (i.e. after reset).
+	*/
+	template< typename Reg >
+	struct Shadowed {
+		static_assert( ( Reg::HardwareUpdated == false ), "Register is updated by hardware, it can't be shadowed" );
+		typedef Reg Description;
+		typedef typename Reg::Value::Type Type;
+
+		template< typename... Fields >
+		static inline void Write( typename Fields::Type... args ) {
+			constexpr const Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+			constexpr const Type ConcatMask = getRegMaskInt< Reg, Fields...>() | NeutralMask;
+			if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
+				_value = getRegValueInt<Reg, Fields...>( args... );
+				_valid = true;
+			} else {
+				Type regValue = Value();
 				regValue &= ~( ConcatMask );
 				regValue |= getRegValueInt<Reg, Fields...>( args... );
-				*reinterpret_cast<volatile typename Reg::Value::Type* const>(_address) = regValue;
-				postWrite();
+				_value = regValue;
+			}
+			Reg::Value::set( _value );
+		}
+
+		template< typename Field >
+		static inline void Set( const typename Field::Type value ) {
+			static_assert( ( Field::Policy == AccessMode::ReadWrite ), "Field is not writable" );
+			Write<Field>( value );
+		}
+
+		template< typename Field >
+		static inline const typename Field::Type Get() {
+			static_assert( ( Reg::getAddress() == Field::getAddress() ), "Please check bitfiled name and resgister");
+			return static_cast<const typename Field::Type>( ( Value() >> Field::Description::getLsb() ) & Field::Description::getLsbMask() );
+		}
+
+		/* Shadow copy value, the register is read only once */
+		static inline const Type Value() {
+			if ( !_valid ) {
+				Sync();
+			}
+			return _value;
+		}
+
+		/* Resync shadow copy from hardware */
+		static inline void Sync() {
+			_value = Reg::Value::get();
+			_valid = true;
+		}
+
+		/* Drop shadow copy, i.e. after peripheral reset */
+		static inline void Invalidate() {
+			_valid = false;
+		}
+
+	private:
+		static inline Type _value { 0 };
+		static inline bool _valid { false };
+	};
+
+	/*
+		Transaction: writes to several registers are issued in program order,
+		without barriers between them. Only one write barrier is issued on Commit(),
+		or when the transaction goes out of scope. It is the strongest level, asked by written registers.
+		Device memory accesses are not reordered with each other, so read of RMW
+		inside the transaction needs one read barrier only (before the first read).
+	*/
+	class Transaction {
+	public:
+		Transaction() {};
+		Transaction( const Transaction& ) = delete;
+		Transaction& operator=( const Transaction& ) = delete;
+		~Transaction() { Commit(); };
+
+		template< typename Reg, typename... Fields >
+		inline void Write( typename Fields::Type... args ) {
+			WriteAt<Reg, Fields...>( Reg::getAddress(), args... );
+		}
+
+		/* Write register of the same layout, placed at another address (i.e. instance of array) */
+		template< typename Reg, typename... Fields >
+		inline void WriteAt( const AddressType address, typename Fields::Type... args ) {
+			static_assert( isWritable< Fields... >(), "Field is not writable" );
+			static_assert( isWriteOneListed< Reg, Fields... >(), "Please list W1C/W1S field in WriteOneFields of register" );
+			constexpr const typename Reg::Value::Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | NeutralMask;
+			if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
+				write<Reg, typename Reg::Value::Type>( address, getRegValueInt<Reg, Fields...>( args... ), ConcatMask );
+			} else if constexpr ( isSetClear< Fields... >() ) {
+				writeSetClearAt<Reg, Fields...>( address, getRegValueInt<Reg, Fields...>( args... ) );
+			} else {
+				reportRmw<Reg>();
+				modify<Reg, typename Reg::Value::Type>( address, ConcatMask, getRegValueInt<Reg, Fields...>( args... ) );
+			}
+		}
+
+		/* Write already composed register value, RMW of mask bits when it isn't whole register */
+		template< typename Reg, typename Reg::Value::Type mask = Reg::Value::Description::getBitMask() >
+		inline void WriteValueAt( const AddressType address, const typename Reg::Value::Type value ) {
+			if constexpr ( mask == Reg::Value::Description::getBitMask() ) {
+				write<Reg, typename Reg::Value::Type>( address, value, mask );
+			} else {
+				modify<Reg, typename Reg::Value::Type>( address, mask, value );
+			}
+		}
+
+		template< typename Field >
+		inline void Set( const typename Field::Type value ) {
+			typedef typename Field::Description Descr;
+			typedef typename Field::RegisterDescription Owner;
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			if constexpr ( isSingleStore< Field >() ) {
+				write<Owner, typename Owner::RegisterValueType>( Field::getAddress(), valueToWrite, Descr::getBitMask() );
+			} else if constexpr ( Field::Policy == AccessMode::SetClear ) {
+				if ( ( Descr::getBitCount() != 1 ) || ( 0 != valueToWrite ) ) {
+					write<Owner, typename Owner::RegisterValueType>( Field::getAddress() + Field::getSetOffset(), valueToWrite, Descr::getBitMask() );
+				}
+				if ( ( Descr::getBitCount() != 1 ) || ( 0 == valueToWrite ) ) {
+					write<Owner, typename Owner::RegisterValueType>( Field::getAddress() + Field::getClearOffset(), ~valueToWrite & Descr::getBitMask(), Descr::getBitMask() );
+				}
+			} else {
+				static_assert( hasPolicy< Field, AccessMode::ReadWrite, AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >(), "Field is not writable" );
+				modify<Owner, typename Owner::RegisterValueType>( Field::getAddress(), getFieldWriteMaskInt< Field >(), valueToWrite );
+			}
+		}
+
+		inline void Commit() {
+			barrier<BarrierType::Store>( _pendingOrder );
+			_pendingOrder = Ordering::None;
+		}
+
+	private:
+		/* Fields of register with SET/CLR aliases, stores to aliases without read (single bit field - one store) */
+		template< typename Reg, typename Field, typename... Fields >
+		inline void writeSetClearAt( const AddressType address, const typename Reg::Value::Type value ) {
+			static_assert( ( ( ( Field::getSetOffset() == Fields::getSetOffset() ) && ( Field::getClearOffset() == Fields::getClearOffset() ) ) && ... ), "Fields have different SET/CLR aliases" );
+			constexpr const typename Reg::Value::Type FieldMask = getRegMaskInt< Reg, Field, Fields...>();
+			if constexpr ( ( sizeof...(Fields) == 0 ) && ( Field::Description::getBitCount() == 1 ) ) {
+				write<Reg, typename Reg::Value::Type>( address + ( ( 0 != value ) ? Field::getSetOffset() : Field::getClearOffset() ), FieldMask, FieldMask );
+			} else {
+				write<Reg, typename Reg::Value::Type>( address + Field::getSetOffset(), value, FieldMask );
+				write<Reg, typename Reg::Value::Type>( address + Field::getClearOffset(), ~value & FieldMask, FieldMask );
+			}
+		}
+
+		/* RMW inside of transaction. Register with concurrency policy is modified by ioModify(), with own barriers */
+		template<typename Owner, typename ValueType>
+		inline void modify( const AddressType address, const ValueType mask, const ValueType value ) {
+			if constexpr ( isPlainRmw<Owner>() ) {
+				ValueType regValue = read<Owner, ValueType>( address, mask );
+				regValue &= ~( mask );
+				regValue |= value;
+				write<Owner, ValueType>( address, regValue, mask );
+			} else {
+				ioModify<IoOwnerOf< Owner >, ValueType>( address, mask, value );
+			}
+		}
+
+		/* Barriers are skipped, cache maintenance and modification masks are applied as usual */
+		template<typename Owner, typename ValueType>
+		inline const ValueType read( const AddressType address, const ValueType mask ) {
+			typedef typename Owner::IoDescription::Access::Read ReadAccess;
+			static_assert( ReadAccess::readable, "Register is not readable" );
+			if constexpr ( ReadAccess::Sync::cpu ) {
+				if ( !_readSynced ) {
+					preRead<ReadAccess::Sync::order>();
+					_readSynced = true;
+				}
+			}
+			if constexpr ( ReadAccess::Sync::cache ) {
+				cacheInvalidate( address, sizeof( ValueType ) );
+			}
+			const ValueType value = modifyRead<Owner, ValueType>( readBus<Owner, ValueType>( address ) );
+			traceRead<ValueType>( address, mask, value );
+			return value;
+		}
+
+		template<typename Owner, typename ValueType>
+		inline void write( const AddressType address, const ValueType value, const ValueType mask ) {
+			typedef typename Owner::IoDescription::Access::Write WriteAccess;
+			static_assert( WriteAccess::writable, "Register is not writable" );
+			const ValueType valueToWrite = modifyWrite<Owner, ValueType>( value );
+			writeBus<Owner, ValueType>( address, valueToWrite );
+			traceWrite<ValueType>( address, mask, valueToWrite );
+			if constexpr ( WriteAccess::Sync::cache ) {
+				cacheClean( address, sizeof( ValueType ) );
+			}
+			if constexpr ( WriteAccess::Sync::cpu ) {
+				if ( _pendingOrder < WriteAccess::Sync::order ) {
+					_pendingOrder = WriteAccess::Sync::order;
+				}
+			}
+		}
+
+	private:
+		Ordering _pendingOrder { Ordering::None };
+		bool _readSynced { false };
+	};
+
+	/*
+		Register description, accessed through another backend. It is used, when address is already
+		resolved into address space of that backend (i.e. mapped base of Linux window + offset).
+	*/
+	template< typename Reg, typename IoArg >
+	struct WithIo : public Reg {
+		typedef IoArg Io;
+	};
+
+	/* Description of register for given backend, it is register itself for its own backend */
+	template< typename Reg, typename IoArg >
+	using OwnerOf = typename std::conditional< std::is_same< typename Reg::Io, IoArg >::value, Reg, WithIo< Reg, IoArg > >::type;
+
+	template< typename Reg, typename IoArg = typename Reg::Io >
+	struct Class {
+		typedef Reg Description;
+		/* Register description, bound to backend of instance */
+		typedef OwnerOf< Reg, IoArg > Owner;
+		Class() : _address( Reg::getAddress())  {};
+		Class( AddressType address ) : _address(address) {};
+
+		template <typename... Fields>
+		inline void Write( typename Fields::Type... args ){
+			static_assert( isWritable< Fields... >(), "Field is not writable" );
+			static_assert( isWriteOneListed< Reg, Fields... >(), "Please list W1C/W1S field in WriteOneFields of register" );
+			constexpr const typename Reg::Value::Type NeutralMask = getRegWriteNeutralMaskInt< Reg >();
+			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | NeutralMask;
+			constexpr const WriteLane Lane = getWriteLane< IoOwnerOf< Reg >, typename Reg::Value::Type >( getRegMaskInt< Reg, Fields...>(), ConcatMask );
+			if constexpr ( ConcatMask == Reg::Value::Description::getBitMask() ) {
+				typename Reg::Value::Type regValue = getRegValueInt<Reg, Fields...>( args... );
+				ioWrite<IoOwnerOf< Owner >, typename Reg::Value::Type>( _address, regValue, ConcatMask );
+			} else if constexpr ( isSetClear< Fields... >() ) {
+				writeSetClearFields<Owner, Fields...>( _address, args... );
+			} else if constexpr ( 0 != Lane.size ) {
+				ioWriteLane<IoOwnerOf< Owner >, typename Reg::Value::Type, Lane.size, Lane.offset>( _address, getRegValueInt<Reg, Fields...>( args... ), ConcatMask );
+			} else {
+				reportRmw<Reg>();
+				ioModify<IoOwnerOf< Owner >, typename Reg::Value::Type>( _address, ConcatMask, getRegValueInt<Reg, Fields...>( args... ) );
 			}
 		}
 
 		template< typename ...Fields>
 		inline void Read( typename Fields::Type&... args ) {
-			preRead();
-			const typename Reg::Value::Type regValue = *reinterpret_cast<volatile typename Reg::Value::Type* const>(_address);
+			const typename Reg::Value::Type regValue = ioRead<IoOwnerOf< Owner >, typename Reg::Value::Type>( _address );
 			getFieldsFromReg<Fields...>( regValue, args... );
 		}
 
 		template< typename... Fields >
-		inline const bool IsEqual( const typename Fields::Type... args )  {
+		inline const bool IsEqual( typename Fields::Type... args )  {
 			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>();
 			const typename Reg::Value::Type maskedValue = getRegValueInt<Reg, Fields...>( args... ) & ConcatMask;
-			preRead();
-			const typename Reg::Value::Type maskedReadValue = (*reinterpret_cast<volatile typename Reg::Value::Type* const>(_address)) & ConcatMask;
+			const typename Reg::Value::Type maskedReadValue = ioRead<IoOwnerOf< Owner >, typename Reg::Value::Type>( _address, ConcatMask ) & ConcatMask;
 			return ( maskedValue == maskedReadValue );
 		};		
 
 		template< typename Field >
 		inline const typename Field::Type Get()  {
 			static_assert( (Reg::getAddress() == Field::getAddress()), "Please check bitfiled name and resgister");
-			preRead();
-			const typename Reg::Value::Type regValue = *reinterpret_cast<volatile typename Reg::Value::Type* const>(_address);
+			const typename Reg::Value::Type regValue = ioRead<IoOwnerOf< Owner >, typename Reg::Value::Type>( _address );
 			return static_cast<const typename Field::Type>( ( regValue >> Field::Description::getLsb() ) & Field::Description::getLsbMask() );
 		};
 
+		inline const AddressType getAddress() const { return _address; }
+
 	private:
-		template< typename Field, typename... Fields>
-		inline void getFieldsFromReg(const typename Reg::Value::Type regValue, typename Field::Type &arg, typename Fields::Type&... args) {
-			static_assert( ( Reg::Value::getAddress() == Field::getAddress() ), "Please check field parameter and register" );
-			static_assert(( Field::Policy != AccessMode::Reserved ), "Trying to read reserved field");
-			arg = static_cast<const typename Field::Type>( ( regValue >> Field::Description::getLsb() ) & Field::Description::getLsbMask() );
-			if constexpr ( sizeof...(Fields) != 0 ) {
-				getFieldsFromReg<Fields...>( regValue, args... );
-			}		
+		template< typename... Fields>
+		inline void getFieldsFromReg(const typename Reg::Value::Type regValue, typename Fields::Type&... args) {
+			Register::getFieldsFromReg< Reg, Fields... >( regValue, args... );
 		}
 
 	private:
 		const AddressType _address { Reg::getAddress() };
 	};
 
+	/*
+		Peripheral block: registers of block are accessed by offset from single runtime base.
+		Block instance is a single pointer, each access is base + constant offset,
+		so compiler keeps base in one CPU register across whole sequence.
+		Base is in address space of block backend IoArg, by default it is backend of each register
+		(CPU address for DirectIo, physical address for Linux::MappedIo, which translates it on each access).
+		Block of backend DirectIo accesses registers by CPU address, i.e. already mapped base
+		( see Linux::MappedBlock, it resolves mapped window once ).
+
+			Register::Block< 0x12010000, 0x1000, Register::DirectIo > crg( mappedBase );
+			crg.Write< PllConfig1, PllConfig1::Bypass >( PllConfig1::Bypass::Type::Bypass );
+	*/
+	template< AddressType physBase, size_t size, typename IoArg = void >
+	class Block {
+	public:
+		/* Backend of register inside of block */
+		template< typename Reg >
+		using IoOf = typename std::conditional< std::is_void< IoArg >::value, typename Reg::Io, IoArg >::type;
+
+		Block() : _base( physBase ) {};
+		explicit Block( const AddressType base ) : _base( base ) {};
+		explicit Block( volatile void* const base ) : _base( reinterpret_cast<AddressType>( base ) ) {};
+
+		/* Offset of register from block base, computed at compile time */
+		template< typename Reg >
+		static constexpr const AddressType getOffset() {
+			static_assert( ( Reg::getAddress() >= physBase ) && ( ( Reg::getAddress() - physBase ) < size ), "Register is outside of block" );
+			return Reg::getAddress() - physBase;
+		}
+
+		template< typename Reg >
+		inline Class< Reg, IoOf<Reg> > at() const {
+			return Class< Reg, IoOf<Reg> >( _base + getOffset<Reg>() );
+		}
+
+		template< typename Reg, typename... Fields >
+		inline void Write( typename Fields::Type... args ) const {
+			at<Reg>().template Write<Fields...>( args... );
+		}
+
+		template< typename Reg, typename... Fields >
+		inline void Read( typename Fields::Type&... args ) const {
+			at<Reg>().template Read<Fields...>( args... );
+		}
+
+		template< typename Reg, typename... Fields >
+		inline const bool IsEqual( typename Fields::Type... args ) const {
+			return at<Reg>().template IsEqual<Fields...>( args... );
+		}
+
+		template< typename Reg, typename Field >
+		inline const typename Field::Type Get() const {
+			return at<Reg>().template Get<Field>();
+		}
+
+		/* Field RMW, as Field::set() does */
+		template< typename Field >
+		inline void Set( const typename Field::Type value ) const {
+			typedef typename Field::Description Descr;
+			typedef OwnerOf< typename Field::RegisterDescription, IoOf< typename Field::RegisterDescription > > Owner;
+			const AddressType address = _base + getOffset<Field>();
+			const typename Owner::RegisterValueType valueToWrite = (static_cast<const typename Owner::RegisterValueType>(value) & Descr::getLsbMask() ) << Descr::getLsb();
+			if constexpr ( isSingleStore< Field >() ) {
+				ioWrite<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( address, valueToWrite, Descr::getBitMask() );
+			} else if constexpr ( Field::Policy == AccessMode::SetClear ) {
+				writeSetClear<Owner, Descr>( address + Field::getSetOffset(), address + Field::getClearOffset(), valueToWrite );
+			} else {
+				static_assert( hasPolicy< Field, AccessMode::ReadWrite, AccessMode::WriteOneToClear, AccessMode::WriteOneToSet >(), "Field is not writable" );
+				ioModify<IoOwnerOf< Owner >, typename Owner::RegisterValueType>( address, getFieldWriteMaskInt< Field >(), valueToWrite );
+			}
+		}
+
+		inline const AddressType getBase() const { return _base; }
+
+	private:
+		const AddressType _base;
+	};
+
+	/*
+		Array of identical registers, placed with constant stride (i.e. channels of peripheral).
+		at<I>() is checked at compile time, at( index ) at run time.
+		Bulk writes compute register value once, stores are unrolled and followed by single barrier.
+
+			typedef Register::Array< PllConfig1, 0x18, 2 > PllConfig1Array;
+			PllConfig1Array::WriteAll< PllConfig1::Bypass >( PllConfig1::Bypass::Type::Bypass );
+	*/
+	template< typename Reg, AddressType stride, size_t count >
+	struct Array {
+		static_assert( ( count > 0 ) && ( count <= 64 ), "Array size must be 1...64" );
+		static_assert( ( stride >= sizeof( typename Reg::Value::Type ) ), "Array stride is less then register size" );
+		typedef Reg Description;
+		typedef uint64_t InstanceMask;
+
+		static constexpr const size_t getCount() { return count; }
+		static constexpr const AddressType getStride() { return stride; }
+		static constexpr const InstanceMask getAllMask() { return ( count == 64 ) ? ~InstanceMask( 0 ) : ( ( InstanceMask( 1 ) << count ) - 1 ); }
+
+		template< size_t index >
+		static constexpr const AddressType getAddress() {
+			static_assert( ( index < count ), "Array index is out of range" );
+			return Reg::getAddress() + ( index * stride );
+		}
+
+		static inline const bool isValid( const size_t index ) { return ( index < count ); }
+
+		template< size_t index >
+		static inline Class<Reg> at() {
+			return Class<Reg>( getAddress<index>() );
+		}
+
+		/*
+			Instance by run-time index. Index out of range executes __builtin_trap() (undefined instruction:
+			exception on bare metal, SIGILL on hosted build), wrong register is never accessed.
+			Check index by isValid(), when it comes from outside.
+		*/
+		static inline Class<Reg> at( const size_t index ) {
+			if ( !isValid( index ) ) {
+				__builtin_trap();
+			}
+			return Class<Reg>( Reg::getAddress() + ( index * stride ) );
+		}
+
+		/* The same field values into all instances */
+		template< typename... Fields >
+		static inline void WriteAll( typename Fields::Type... args ) {
+			WriteSome< getAllMask(), Fields... >( args... );
+		}
+
+		/* The same field values into instances of compile-time mask (bit N - instance N) */
+		template< InstanceMask instances, typename... Fields >
+		static inline void WriteSome( typename Fields::Type... args ) {
+			static_assert( ( ( instances & ~getAllMask() ) == 0 ), "Array instance mask is out of range" );
+			static_assert( isWritable< Fields... >(), "Field is not writable" );
+			static_assert( isWriteOneListed< Reg, Fields... >(), "Please list W1C/W1S field in WriteOneFields of register" );
+			Transaction transaction;
+			writeUnrolled< instances, Fields... >( transaction, std::make_index_sequence<count>(), args... );
+		}
+
+		/* The same field values into instances of run-time mask. Returns false if mask is out of range */
+		template< typename... Fields >
+		static inline bool Write( const InstanceMask instances, typename Fields::Type... args ) {
+			static_assert( isWritable< Fields... >(), "Field is not writable" );
+			static_assert( isWriteOneListed< Reg, Fields... >(), "Please list W1C/W1S field in WriteOneFields of register" );
+			if ( ( instances & ~getAllMask() ) != 0 ) {
+				return false;
+			}
+			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | getRegWriteNeutralMaskInt< Reg >();
+			const typename Reg::Value::Type value = getRegValueInt<Reg, Fields...>( args... );
+			Transaction transaction;
+			for ( size_t index = 0; index < count; index++ ) {
+				if ( instances & ( InstanceMask( 1 ) << index ) ) {
+					if constexpr ( isSetClear< Fields... >() ) {
+						transaction.WriteAt<Reg, Fields...>( Reg::getAddress() + ( index * stride ), args... );
+					} else {
+						transaction.WriteValueAt< Reg, ConcatMask >( Reg::getAddress() + ( index * stride ), value );
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		template< InstanceMask instances, typename... Fields, size_t... indexes >
+		static inline void writeUnrolled( Transaction& transaction, std::index_sequence<indexes...>, typename Fields::Type... args ) {
+			constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | getRegWriteNeutralMaskInt< Reg >();
+			if constexpr ( isSetClear< Fields... >() ) {
+				( ( ( instances & ( InstanceMask( 1 ) << indexes ) ) ? transaction.WriteAt<Reg, Fields...>( getAddress<indexes>(), args... ) : void() ), ... );
+			} else {
+				const typename Reg::Value::Type value = getRegValueInt<Reg, Fields...>( args... );
+				( ( ( instances & ( InstanceMask( 1 ) << indexes ) ) ? transaction.WriteValueAt< Reg, ConcatMask >( getAddress<indexes>(), value ) : void() ), ... );
+			}
+		}
+	};
+
+	/*
+		Snapshot: register is read once, fields are decoded from RAM copy on access,
+		so unused fields cost nothing. Fields listed in template arguments are available
+		by index and by structured bindings.
+
+			auto [ bypass, fbdiv ] = Register::Snapshot< PllConfig1, PllConfig1::Bypass, PllConfig1::FBdiv >();
+			Register::Snapshot< PllConfig1 > before( crg.at< PllConfig1 >() );
+			...
+			if ( before.Changed< PllConfig1::Bypass >( Register::Snapshot< PllConfig1 >() ) ) { ... }
+	*/
+	template< typename Reg, typename... Fields >
+	class Snapshot {
+	public:
+		typedef Reg Description;
+		typedef typename Reg::Value::Type Type;
+
+		/* Register of static description */
+		Snapshot() : _value( ioRead<IoOwnerOf< Reg >, Type>( Reg::getAddress() ) ) {};
+		/* Runtime addressed register instance */
+		template< typename IoArg >
+		explicit Snapshot( const Class<Reg, IoArg>& instance ) : _value( ioRead<IoOwnerOf< typename Class<Reg, IoArg>::Owner >, Type>( instance.getAddress() ) ) {};
+
+		/* Snapshot of known value, without bus access */
+		static inline Snapshot FromValue( const Type value ) { return Snapshot( value, 0 ); }
+
+		template< typename Field >
+		inline const typename Field::Type Get() const {
+			static_assert( ( Reg::getAddress() == Field::getAddress() ), "Please check bitfiled name and resgister");
+			static_assert( ( Field::Policy != AccessMode::Reserved ), "Trying to read reserved field" );
+			static_assert( ( Field::Policy != AccessMode::WriteOnly ), "Trying to read write only field" );
+			return static_cast<const typename Field::Type>( ( _value >> Field::Description::getLsb() ) & Field::Description::getLsbMask() );
+		}
+
+		/* Field by index of template arguments (structured bindings) */
+		template< size_t index >
+		inline const typename std::tuple_element< index, std::tuple< typename Fields::Type... > >::type get() const {
+			return Get< typename std::tuple_element< index, std::tuple< Fields... > >::type >();
+		}
+
+		inline const Type getValue() const { return _value; }
+
+		/* Changed bits of two snapshots, reserved bits are ignored */
+		template< typename... OtherFields >
+		inline const Type getChangedMask( const Snapshot< Reg, OtherFields... >& other ) const {
+			return ( _value ^ other.getValue() ) & ~getRegReservedMaskInt< Reg >();
+		}
+
+		template< typename Field, typename... OtherFields >
+		inline const bool Changed( const Snapshot< Reg, OtherFields... >& other ) const {
+			static_assert( ( Reg::getAddress() == Field::getAddress() ), "Please check bitfiled name and resgister");
+			return ( 0 != ( getChangedMask( other ) & Field::Description::getBitMask() ) );
+		}
+
+		/* Changed fields of template arguments, bit N is set when N-th field is changed */
+		template< typename... OtherFields >
+		inline const uint32_t Diff( const Snapshot< Reg, OtherFields... >& other ) const {
+			static_assert( ( sizeof...(Fields) <= 32 ), "Too many fields to diff" );
+			const Type changed = getChangedMask( other );
+			return diff( changed, std::index_sequence_for< Fields... >() );
+		}
+
+	private:
+		Snapshot( const Type value, int ) : _value( value ) {};
+
+		template< size_t... indexes >
+		static inline const uint32_t diff( const Type changed, std::index_sequence< indexes... > ) {
+			return ( 0u | ... | ( ( 0 != ( changed & Fields::Description::getBitMask() ) ) ? ( 1u << indexes ) : 0u ) );
+		}
+
+	private:
+		const Type _value;
+	};
+
+	/* The strongest read ordering of registers */
+	template< typename... Regs >
+	constexpr const Ordering getReadOrder() {
+		Ordering order = Ordering::None;
+		( ( order = ( Regs::IoDescription::Access::Read::Sync::order > order ) ? Regs::IoDescription::Access::Read::Sync::order : order ), ... );
+		return order;
+	}
+
+	/* Read without barrier, caller orders group of reads by single barrier */
+	template< typename Owner, typename ValueType >
+	inline const ValueType ioReadRelaxed( const AddressType address ) {
+		static_assert( Owner::IoDescription::Access::Read::readable, "Register is not readable" );
+		if constexpr ( Owner::IoDescription::Access::Read::Sync::cache ) {
+			cacheInvalidate( address, sizeof( ValueType ) );
+		}
+		typedef IoOwnerOf< Owner > Bus;
+		const ValueType value = modifyRead<Bus, ValueType>( readBus<Bus, ValueType>( address ) );
+		traceRead<ValueType>( address, ~static_cast<ValueType>( 0 ), value );
+		return value;
+	}
+
+	/* Index of register in list, or size of list, when register isn't in list */
+	template< typename Reg, typename... Regs >
+	constexpr const size_t findRegIndex() {
+		constexpr const bool matches[] = { std::is_same< Reg, Regs >::value..., true };
+		size_t index = 0;
+		while ( !matches[ index ] ) {
+			index++;
+		}
+		return index;
+	}
+
+	/* Index of register in list */
+	template< typename Reg, typename... Regs >
+	constexpr const size_t getRegIndex() {
+		static_assert( ( std::is_same< Reg, Regs >::value || ... ), "Register is not in list" );
+		return findRegIndex< Reg, Regs... >();
+	}
+
+	/* Values of register group, read by ConsistentRead */
+	template< typename... Regs >
+	class Consistent {
+	public:
+		static_assert( ( sizeof...(Regs) >= 2 ), "Consistent read needs guard register and at least one more register" );
+		typedef typename std::tuple_element< 0, std::tuple< Regs... > >::type Guard;
+
+		static inline Consistent Read( const uint32_t retries ) {
+			barrier< getReadOrder< Regs... >(), BarrierType::Load >();
+			Consistent result;
+			while ( true ) {
+				result._attempts++;
+				result.readGroup( std::index_sequence_for< Regs... >() );
+				const typename Guard::Value::Type guard = std::get< 0 >( result._values );
+				if ( ( !Guard::SequenceCounter || ( 0 == ( guard & 1 ) ) ) &&
+					( ioReadRelaxed< IoOwnerOf< Guard >, typename Guard::Value::Type >( Guard::getAddress() ) == guard ) ) {
+					result._consistent = true;
+					return result;
+				}
+				if ( result._attempts > retries ) {
+					return result;
+				}
+			}
+		}
+
+		template< typename Reg >
+		inline const typename Reg::Value::Type Value() const {
+			return std::get< getRegIndex< Reg, Regs... >() >( _values );
+		}
+
+		template< typename Reg, typename Field >
+		inline const typename Field::Type Get() const {
+			return getSnapshot< Reg >().template Get< Field >();
+		}
+
+		template< typename Reg >
+		inline Snapshot< Reg > getSnapshot() const {
+			return Snapshot< Reg >::FromValue( Value< Reg >() );
+		}
+
+		/* Values are consistent, otherwise the last (possibly torn) attempt is kept */
+		inline const bool IsConsistent() const { return _consistent; }
+		inline const uint32_t getAttempts() const { return _attempts; }
+		explicit operator bool() const { return _consistent; }
+
+	private:
+		template< size_t... indexes >
+		inline void readGroup( std::index_sequence< indexes... > ) {
+			( ( std::get< indexes >( _values ) = ioReadRelaxed< IoOwnerOf< Regs >, typename Regs::Value::Type >( Regs::getAddress() ) ), ... );
+		}
+
+	private:
+		std::tuple< typename Regs::Value::Type... > _values {};
+		uint32_t _attempts { 0 };
+		bool _consistent { false };
+	};
+
+	/*
+		Consistent read of value, which spans several registers (i.e. 64 bit counter as HI and LO registers).
+		The first register is read again after the others: group is consistent, when it isn't changed
+		(hi-lo-hi). It is upper word of counter, or version (sequence) register of hardware.
+		Sequence counter, which is odd while hardware updates group (seqlock), declares
+			static constexpr const bool SequenceCounter = true;
+		then group, read with odd counter, isn't consistent, even if counter isn't changed.
+		Group is read up to 1 + retries times, with single read barrier for all of them.
+
+			auto counter = Register::ConsistentRead< CounterHi, CounterLo >();
+			if ( counter ) {
+				const uint64_t value = ( uint64_t( counter.Value< CounterHi >() ) << 32 ) | counter.Value< CounterLo >();
+			}
+	*/
+	template< typename... Regs >
+	inline Consistent< Regs... > ConsistentRead( const uint32_t retries = 3 ) {
+		return Consistent< Regs... >::Read( retries );
+	}
+
+	/*
+		Registers, which are restored before this one (i.e. PLLs before clock select).
+		Description declares them as
+			typedef Dependencies< PllConfig0, PllConfig1 > RestoreAfter;
+	*/
+	template< typename... Deps >
+	struct Dependencies {
+		/* Dependencies, which are in list, are placed before position */
+		template< typename... Regs >
+		static constexpr const bool isBefore( const size_t position ) {
+			return ( ( ( findRegIndex< Deps, Regs... >() < position ) || ( findRegIndex< Deps, Regs... >() == sizeof...(Regs) ) ) && ... );
+		}
+	};
+
+	template< typename Reg, typename = void >
+	struct hasRestoreAfter : std::false_type {};
+
+	template< typename Reg >
+	struct hasRestoreAfter< Reg, std::void_t< typename Reg::RestoreAfter > > : std::true_type {};
+
+	/* Dependencies of register are placed before it in list */
+	template< typename Reg, typename... Regs >
+	constexpr const bool isRestoreOrdered() {
+		if constexpr ( hasRestoreAfter< Reg >::value ) {
+			return Reg::RestoreAfter::template isBefore< Regs... >( getRegIndex< Reg, Regs... >() );
+		} else {
+			return true;
+		}
+	}
+
+	/*
+		Register context: values of register set are saved into packed buffer and restored
+		(suspend/resume, failover). Only restorable bits are kept ( see getRegRestoreMaskInt ):
+		reserved, read-only ( ReadOnlyFields ) and write-one ( WriteOneFields ) bits are skipped,
+		register without restorable bits is neither read, nor written, and it has no place in buffer.
+		Register updated by hardware ( HardwareUpdated ) must list its read-only fields.
+		Registers are restored in the order of list, so list is the dependency order.
+		It is checked against RestoreAfter dependencies of descriptions at compile time.
+
+			typedef Register::Context< PllConfig0, PllConfig1, PllConfig6, PllConfig7, SocClkSel > CrgContext;
+			CrgContext context;
+			context.Save();						// relaxed reads, single trailing barrier
+			...
+			context.Restore();					// stores in list order, single trailing barrier
+			context.RestoreDiff();				// stores only registers, which live value differs
+			context.RestoreDiff( shadow );		// live value is taken from shadow context, no bus reads
+
+		Each restore is a single store of register ( reserved and write-one bits are written as 0 ).
+		Read of register with RC fields clears them, so such registers shouldn't be saved.
+	*/
+	template< typename... Regs >
+	class Context {
+	public:
+		static_assert( ( sizeof...(Regs) != 0 ), "Context needs at least one register" );
+		static_assert( ( isRestoreOrdered< Regs, Regs... >() && ... ), "Register is placed before registers of its RestoreAfter dependencies" );
+		static_assert( ( ( !Regs::HardwareUpdated || hasReadOnlyFields< Regs >::value ) && ... ),
+			"Register is updated by hardware, please list its RO/RC fields by ReadOnlyFields, they must not be restored" );
+
+		/* Size of packed buffer, values of restorable registers are placed without padding */
+		static constexpr const size_t getSize() {
+			return ( getPackedSize< Regs >() + ... );
+		}
+
+		/* Save restorable registers: reads are not ordered with each other, barrier is issued after the last one */
+		inline void Save() {
+			( save< Regs >(), ... );
+			barrier< getReadOrder< Regs... >(), BarrierType::Load >();
+		}
+
+		/* Save reset values of registers (i.e. shadow of peripheral after reset), there are no bus accesses */
+		inline void SaveReset() {
+			static_assert( ( ( ( getResetKnownMaskInt< Regs >() & getRegRestoreMaskInt< Regs >() ) == getRegRestoreMaskInt< Regs >() ) && ... ),
+				"Reset value of register is unknown, please describe ResetValue or FieldDefaults of register" );
+			( store< Regs >( getResetValueInt< Regs >() & getRegRestoreMaskInt< Regs >() ), ... );
+		}
+
+		/* Write all restorable registers */
+		inline void Restore() const {
+			Transaction transaction;
+			( restore< Regs >( transaction ), ... );
+		}
+
+		/* Write registers, which live restorable bits differ from saved ones. Returns number of written registers */
+		inline size_t RestoreDiff() const {
+			std::tuple< typename Regs::Value::Type... > live {};
+			barrier< getReadOrder< Regs... >(), BarrierType::Load >();
+			( readLive< Regs >( std::get< getRegIndex< Regs, Regs... >() >( live ) ), ... );
+			size_t written = 0;
+			Transaction transaction;
+			( ( written += restoreDiff< Regs >( transaction, std::get< getRegIndex< Regs, Regs... >() >( live ) ) ), ... );
+			return written;
+		}
+
+		/* Write registers, which differ from shadow context. Shadow is updated, it is equal to this context after restore */
+		inline size_t RestoreDiff( Context& shadow ) const {
+			size_t written = 0;
+			Transaction transaction;
+			( ( written += restoreDiff< Regs >( transaction, shadow.Value< Regs >() ) ), ... );
+			shadow = *this;
+			return written;
+		}
+
+		/* Saved value of register, only restorable bits */
+		template< typename Reg >
+		inline const typename Reg::Value::Type Value() const {
+			typename Reg::Value::Type value = 0;
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				__builtin_memcpy( &value, &_buffer[ getOffset< Reg >() ], sizeof( value ) );
+			}
+			return value;
+		}
+
+		template< typename Reg, typename Field >
+		inline const typename Field::Type Get() const {
+			return Snapshot< Reg >::FromValue( Value< Reg >() ).template Get< Field >();
+		}
+
+		/* Packed buffer, i.e. to keep it in retention memory, or to send it to standby node */
+		inline const uint8_t* getData() const { return _buffer; }
+		inline uint8_t* getData() { return _buffer; }
+
+	private:
+		template< typename Reg >
+		static constexpr const size_t getPackedSize() {
+			return ( 0 != getRegRestoreMaskInt< Reg >() ) ? sizeof( typename Reg::Value::Type ) : 0;
+		}
+
+		template< typename Reg >
+		static constexpr const size_t getOffset() {
+			constexpr const size_t sizes[] = { getPackedSize< Regs >()... };
+			size_t offset = 0;
+			for ( size_t index = 0; index < getRegIndex< Reg, Regs... >(); index++ ) {
+				offset += sizes[ index ];
+			}
+			return offset;
+		}
+
+		template< typename Reg >
+		inline void store( const typename Reg::Value::Type value ) {
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				__builtin_memcpy( &_buffer[ getOffset< Reg >() ], &value, sizeof( value ) );
+			}
+		}
+
+		template< typename Reg >
+		inline void save() {
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				store< Reg >( ioReadRelaxed< IoOwnerOf< Reg >, typename Reg::Value::Type >( Reg::getAddress() ) & getRegRestoreMaskInt< Reg >() );
+			}
+		}
+
+		template< typename Reg >
+		static inline void readLive( typename Reg::Value::Type& value ) {
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				value = ioReadRelaxed< IoOwnerOf< Reg >, typename Reg::Value::Type >( Reg::getAddress() ) & getRegRestoreMaskInt< Reg >();
+			}
+		}
+
+		template< typename Reg >
+		inline void restore( Transaction& transaction ) const {
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				transaction.WriteValueAt< Reg >( Reg::getAddress(), Value< Reg >() );
+			}
+		}
+
+		template< typename Reg >
+		inline size_t restoreDiff( Transaction& transaction, const typename Reg::Value::Type live ) const {
+			if constexpr ( 0 != getRegRestoreMaskInt< Reg >() ) {
+				if ( ( live & getRegRestoreMaskInt< Reg >() ) != Value< Reg >() ) {
+					transaction.WriteValueAt< Reg >( Reg::getAddress(), Value< Reg >() );
+					return 1;
+				}
+			}
+			return 0;
+		}
+
+	private:
+		static_assert( ( getSize() != 0 ), "Context has no restorable register" );
+		uint8_t _buffer[ getSize() ] {};
+	};
+
+} // Register
+
+/* Structured bindings of Register::Snapshot */
+namespace std {
+	template< typename Reg, typename... Fields >
+	struct tuple_size< Register::Snapshot< Reg, Fields... > > : std::integral_constant< size_t, sizeof...(Fields) > {};
+
+	template< size_t index, typename Reg, typename... Fields >
+	struct tuple_element< index, Register::Snapshot< Reg, Fields... > > : std::tuple_element< index, std::tuple< typename Fields::Type... > > {};
 }
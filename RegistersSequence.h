@@ -0,0 +1,258 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Register programming sequences					*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <utility>
+#include <type_traits>
+#include <RegistersClass.h>
+
+namespace Register {
+namespace Sequence {
+
+	/*
+		Register programming sequence is declared as constexpr table of steps.
+		Address, mask and value of each step are computed at compile time, so table is placed
+		into .rodata, and it is executed by small interpreter (Run), or fully unrolled (RunUnrolled).
+
+			static constexpr const Register::Sequence::StepOf< PllConfig0 > pllSequence[] = {
+				Register::Sequence::Write< PllConfig0, PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( 0, 2, 1 ),
+				Register::Sequence::Delay( 100 ),
+				Register::Sequence::WaitFor< PllLockStatus, PllLockStatus::APll >( 100000, PllLockStatus::APll::Type::Locked ),
+			};
+			Register::Sequence::Run( pllSequence );				// size
+			Register::Sequence::RunUnrolled< pllSequence >();	// speed
+
+		Timeout of WaitFor and duration of Delay are counted by time base of Run (see Polls and Clocked):
+		by default they are reads and busy loop iterations, not time.
+
+		Step type carries Io and IoDescription of its registers (Target), so table is executed
+		by backend, ordering and Rmw policy of registers. All steps of table must have the same Target,
+		step of register with another Io or IoDescription isn't converted (compile error).
+		Run is one function per ValueType and Target, table size is its argument.
+
+		Step is compact (16 bytes of 32-bit register on 64-bit host): register is 32-bit offset from base
+		of Target, and operation shares 32-bit word with 24-bit argument. Register, which is out of 4GB
+		from base, or bigger argument is compile error of constexpr table. Registers above 4GB are
+		placed into table of Target with their base:
+			static constexpr const Register::Sequence::StepOf< Reg, 0x800000000 > sequence[] = { ... };
+	*/
+
+	enum class Op : uint8_t {
+		/* Store value, register is not read */
+		Write,
+		/* Read register, replace mask bits by value, store */
+		Modify,
+		/* Poll register, until ( register & mask ) == value, or arg (timeout) expires */
+		WaitEqual,
+		/* Busy loop, until arg (duration) expires */
+		Delay
+	};
+
+	/* Register access backend, IoDescription and base address of sequence */
+	template< typename IoArg = DirectIo, typename IoDescriptionArg = MemIoDescription<>, AddressType baseArg = 0 >
+	struct Target {
+		typedef IoArg Io;
+		typedef IoDescriptionArg IoDescription;
+		static constexpr const AddressType base = baseArg;
+	};
+
+	template< typename Reg, AddressType base = 0 >
+	using TargetOf = Target< typename Reg::Io, typename Reg::IoDescription, base >;
+
+	static constexpr const uint32_t MaxStepArg = ( static_cast<uint32_t>( 1 ) << 24 ) - 1;
+
+	template< typename ValueType = DefaultValueType, typename TargetArg = Target<> >
+	struct Step {
+		typedef TargetArg Owner;
+		ValueType mask;
+		ValueType value;
+		/* Register address is Owner::base + offset */
+		uint32_t offset;
+		uint32_t arg : 24;
+		Op op : 8;
+	};
+
+	/* Step of register "Reg" (table element type) */
+	template< typename Reg, AddressType base = 0 >
+	using StepOf = Step< typename Reg::Value::Type, TargetOf< Reg, base > >;
+
+	/* Value doesn't fit into step: __builtin_trap() isn't constant expression, so constexpr table doesn't compile */
+	constexpr const uint32_t getStepArg( const uint32_t arg ) {
+		if ( arg > MaxStepArg ) {
+			__builtin_trap();
+		}
+		return arg;
+	}
+
+	template< AddressType base >
+	constexpr const uint32_t getStepOffset( const AddressType address ) {
+		if ( ( address < base ) || ( ( address - base ) > UINT32_MAX ) ) {
+			__builtin_trap();
+		}
+		return static_cast<uint32_t>( address - base );
+	}
+
+	/* Step of register, it is converted to step of table with the same ValueType, Io and IoDescription (offset from table base) */
+	template< typename Reg >
+	struct RegisterStep {
+		AddressType address;
+		typename Reg::Value::Type mask;
+		typename Reg::Value::Type value;
+		uint32_t arg;
+		Op op;
+
+		template< typename ValueType, typename TargetArg >
+		constexpr operator Step< ValueType, TargetArg >() const {
+			static_assert( std::is_same< Step< ValueType, TargetArg >, StepOf< Reg, TargetArg::base > >::value, "Step register has another ValueType, Io or IoDescription then sequence table" );
+			return Step< ValueType, TargetArg > { mask, value, getStepOffset< TargetArg::base >( address ), getStepArg( arg ), op };
+		}
+	};
+
+	/*
+		Write fields, omitted ones are kept (Modify), or register is written at once (Write).
+		SET/CLR field is written by two alias stores, step has one store, so it isn't accepted.
+	*/
+	template< typename Reg, typename... Fields >
+	constexpr const RegisterStep< Reg > Write( typename Fields::Type... args ) {
+		static_assert( isWritable< Fields... >(), "Field is not writable" );
+		static_assert( !( ( Fields::Policy == AccessMode::SetClear ) || ... ), "SET/CLR field can't be a sequence step, please write it by Register::Write or Transaction" );
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>() | getRegWriteNeutralMaskInt< Reg >();
+		constexpr const Op op = ( ConcatMask == Reg::Value::Description::getBitMask() ) ? Op::Write : Op::Modify;
+		static_assert( ( Op::Write == op ) || !isRmwForbidden< Reg >(), "Register has RC fields, RMW is forbidden (its read clears them): please write all fields" );
+		return RegisterStep< Reg > { Reg::getAddress(), ConcatMask, getRegValueInt<Reg, Fields...>( args... ), 0, op };
+	}
+
+	/* Wait for fields are equal to values, no longer then timeout (reads or microseconds, see time base of Run) */
+	template< typename Reg, typename... Fields >
+	constexpr const RegisterStep< Reg > WaitFor( const uint32_t timeout, typename Fields::Type... args ) {
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>();
+		return RegisterStep< Reg > { Reg::getAddress(), ConcatMask, getRegValueInt<Reg, Fields...>( args... ) & ConcatMask, timeout, Op::WaitEqual };
+	}
+
+	/* Delay doesn't access registers, so it is converted to step of any table */
+	struct DelayStep {
+		uint32_t duration;
+
+		template< typename ValueType, typename TargetArg >
+		constexpr operator Step< ValueType, TargetArg >() const {
+			return Step< ValueType, TargetArg > { 0, 0, 0, getStepArg( duration ), Op::Delay };
+		}
+	};
+
+	/* Busy delay (loop iterations or microseconds, see time base of Run) */
+	constexpr const DelayStep Delay( const uint32_t duration ) {
+		return DelayStep { duration };
+	}
+
+	/*
+		Time base of WaitFor timeout and Delay duration.
+			Polls			- timeout is number of register reads, delay is number of busy loop iterations.
+							  Clock isn't needed (boot ROM), but real time depends on CPU and bus clocks.
+			Clocked<Clock>	- timeout and delay are microseconds of std::chrono compatible clock (now(), duration).
+							  Bare-metal users pass their own clock, i.e. based on CPU cycle counter or system timer.
+		Timer of step is constructed, when step starts, expired() is checked after each read or loop iteration.
+	*/
+	struct Polls {
+		class Timer {
+		public:
+			explicit Timer( const uint32_t count ) : _left( count ) {};
+			inline bool expired() {
+				if ( 0 == _left ) {
+					return true;
+				}
+				_left--;
+				return false;
+			}
+		private:
+			uint32_t _left;
+		};
+	};
+
+	template< typename ClockArg = std::chrono::steady_clock >
+	struct Clocked {
+		typedef ClockArg Clock;
+		class Timer {
+		public:
+			explicit Timer( const uint32_t microseconds ) : _deadline( Clock::now() + std::chrono::microseconds( microseconds ) ) {};
+			inline bool expired() const {
+				return Clock::now() >= _deadline;
+			}
+		private:
+			const typename Clock::time_point _deadline;
+		};
+	};
+
+	/* Execute one step, returns false on wait timeout */
+	template< typename Time = Polls, typename Owner, typename ValueType >
+	inline bool runStep( const Step< ValueType, Owner >& step ) {
+		const AddressType address = Owner::base + step.offset;
+		switch ( step.op ) {
+			case Op::Write:
+				ioWrite<Owner, ValueType>( address, step.value, step.mask );
+				return true;
+			case Op::Modify:
+				/* Step of Rmw::Forbidden register is never Modify ( Write() checks it ) */
+				if constexpr ( !isRmwForbidden< Owner >() ) {
+					ioModify<Owner, ValueType>( address, step.mask, step.value );
+				}
+				return true;
+			case Op::WaitEqual: {
+				typename Time::Timer timer( step.arg );
+				while ( !timer.expired() ) {
+					if ( ( ioRead<Owner, ValueType>( address, step.mask ) & step.mask ) == step.value ) {
+						return true;
+					}
+				}
+				return false;
+			}
+			case Op::Delay: {
+				typename Time::Timer timer( step.arg );
+				while ( !timer.expired() ) {
+					asm volatile ("nop");
+				}
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*
+		Table interpreter, one per ValueType, Target and time base. Returns number of completed steps, it is less then count on wait timeout
+			Register::Sequence::Run< Register::Sequence::Clocked<> >( pllSequence );	// timeouts and delays are microseconds
+	*/
+	template< typename Time = Polls, typename ValueType, typename Owner >
+	__attribute__((noinline)) size_t Run( const Step< ValueType, Owner >* const steps, const size_t count ) {
+		for ( size_t index = 0; index < count; index++ ) {
+			if ( !runStep<Time>( steps[ index ] ) ) {
+				return index;
+			}
+		}
+		return count;
+	}
+
+	template< typename Time = Polls, typename ValueType, typename Owner, size_t count >
+	inline size_t Run( const Step< ValueType, Owner > ( &steps )[ count ] ) {
+		return Run<Time, ValueType, Owner>( steps, count );
+	}
+
+	template< const auto& steps, typename Time, size_t... indexes >
+	inline size_t runUnrolled( std::index_sequence< indexes... > ) {
+		size_t completed = 0;
+		( ( runStep<Time>( steps[ indexes ] ) && ( ++completed, true ) ) && ... );
+		return completed;
+	}
+
+	/* Fully unrolled sequence, each step is compiled with constant address, mask and value */
+	template< const auto& steps, typename Time = Polls >
+	inline size_t RunUnrolled() {
+		constexpr const size_t count = sizeof( steps ) / sizeof( steps[0] );
+		return runUnrolled< steps, Time >( std::make_index_sequence< count >() );
+	}
+
+} // Sequence
+} // Register
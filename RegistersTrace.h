@@ -0,0 +1,145 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Register access tracing							*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+/*
+	Tracing is enabled at compile time by REGISTER_TRACE definition,
+	otherwise generated code is the same as without tracing.
+	REGISTER_TRACE_SIZE is ring size (records), power of 2.
+	REGISTER_TRACE_TIMESTAMP() may be defined to override cycle counter.
+*/
+#ifndef REGISTER_TRACE_SIZE
+#define REGISTER_TRACE_SIZE 256
+#endif
+
+namespace Register {
+namespace Trace {
+
+	enum class Op : uint8_t {
+		Read,
+		Write
+	};
+
+	struct Record {
+		uint64_t timestamp;
+		uint64_t address;
+		uint64_t mask;
+		uint64_t value;
+		Op op;
+	};
+
+	/* CPU cycle counter */
+	inline uint64_t timestamp(void) {
+#if defined(REGISTER_TRACE_TIMESTAMP)
+		return REGISTER_TRACE_TIMESTAMP();
+#elif defined(__x86_64__) || defined(__i386__)
+		return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+		uint64_t value;
+		asm volatile ("mrs %0, cntvct_el0" : "=r"(value));
+		return value;
+#elif defined(__arm__) && !defined(__linux__)
+		uint32_t value;
+		asm volatile ("mrc p15, 0, %0, c9, c13, 0" : "=r"(value));	// PMCCNTR
+		return value;
+#else
+		return 0;
+#endif
+	}
+
+	/*
+		Fixed size lock-free ring, safe with multiple producers (threads, ISR).
+		Producer takes unique index by single atomic increment, writes record and publishes it
+		by sequence number of slot. The oldest records are overwritten.
+		Producers of index and index + size get the same slot. If they write it at once
+		(ring is wrapped while the first one is preempted), the slot is owned by first one,
+		record of second one is dropped and counted by dropped(). So record is never mixed.
+	*/
+	template<size_t size>
+	class Ring {
+		static_assert( ( size != 0 ) && ( ( size & ( size - 1 ) ) == 0 ), "Trace ring size must be power of 2" );
+	public:
+		inline void push( const Op op, const uint64_t address, const uint64_t mask, const uint64_t value ) {
+			const uint32_t index = _head.fetch_add( 1, std::memory_order_relaxed );
+			Slot& slot = _slots[ index & ( size - 1 ) ];
+			if ( slot.busy.exchange( true, std::memory_order_acquire ) ) {
+				_dropped.fetch_add( 1, std::memory_order_relaxed );
+				return;
+			}
+			slot.sequence.store( 0, std::memory_order_relaxed );
+			/* Reader must not see new record fields with old sequence */
+			std::atomic_thread_fence( std::memory_order_release );
+			slot.record.timestamp = timestamp();
+			slot.record.address = address;
+			slot.record.mask = mask;
+			slot.record.value = value;
+			slot.record.op = op;
+			slot.sequence.store( index + 1, std::memory_order_release );
+			slot.busy.store( false, std::memory_order_release );
+		}
+
+		/* Copy up to "count" the latest complete records, from the oldest one. Returns number of records */
+		size_t read( Record* const records, const size_t count ) const {
+			const uint32_t head = _head.load( std::memory_order_acquire );
+			const uint32_t available = ( head < size ) ? head : static_cast<uint32_t>( size );
+			const uint32_t wanted = ( available < count ) ? available : static_cast<uint32_t>( count );
+			size_t copied = 0;
+			for ( uint32_t index = head - wanted; index != head; index++ ) {
+				const Slot& slot = _slots[ index & ( size - 1 ) ];
+				if ( slot.sequence.load( std::memory_order_acquire ) != ( index + 1 ) ) {
+					continue;
+				}
+				const Record record = slot.record;
+				std::atomic_thread_fence( std::memory_order_acquire );
+				if ( slot.sequence.load( std::memory_order_relaxed ) == ( index + 1 ) ) {
+					records[ copied++ ] = record;
+				}
+			}
+			return copied;
+		}
+
+		/* Number of records pushed since start (wraps) */
+		uint32_t pushed() const { return _head.load( std::memory_order_relaxed ); }
+
+		/* Number of records dropped, because producer of the same slot was still writing it (wraps) */
+		uint32_t dropped() const { return _dropped.load( std::memory_order_relaxed ); }
+
+		void clear() {
+			for ( Slot& slot : _slots ) {
+				slot.sequence.store( 0, std::memory_order_relaxed );
+			}
+			_dropped.store( 0, std::memory_order_relaxed );
+			_head.store( 0, std::memory_order_release );
+		}
+
+	private:
+		struct Slot {
+			std::atomic<uint32_t> sequence { 0 };
+			std::atomic<bool> busy { false };
+			Record record {};
+		};
+
+		std::atomic<uint32_t> _head { 0 };
+		std::atomic<uint32_t> _dropped { 0 };
+		Slot _slots[ size ];
+	};
+
+	/* Constant initialized, so there is no guard (lock) on first use */
+	inline Ring<REGISTER_TRACE_SIZE> traceRing;
+
+	inline Ring<REGISTER_TRACE_SIZE>& ring() {
+		return traceRing;
+	}
+
+	inline void record( const Op op, const uint64_t address, const uint64_t mask, const uint64_t value ) {
+		ring().push( op, address, mask, value );
+	}
+
+} // Trace
+} // Register
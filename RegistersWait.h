@@ -0,0 +1,236 @@
+
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Register polling engine							*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+#include <RegistersClass.h>
+
+#if defined(__linux__)
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace Register {
+namespace Wait {
+
+	enum class Status {
+		Done,
+		Timeout
+	};
+
+	/* Result of wait. Elapsed time is measured by the clock of wait policy */
+	template<typename Clock>
+	struct Result {
+		Status status;
+		typename Clock::duration elapsed;
+		uint32_t polls;
+
+		explicit operator bool() const { return ( Status::Done == status ); }
+	};
+
+	/* Hint to CPU, that it is in spin loop */
+	inline void cpuRelax(void) {
+#if defined(__aarch64__) || defined(__arm__)
+		asm volatile ("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+		asm volatile ("pause" ::: "memory");
+#else
+		asm volatile ("" ::: "memory");
+#endif
+	}
+
+	/* Sleep until event (or interrupt), falls back to relax hint */
+	inline void waitForEvent(void) {
+#if defined(__aarch64__) || defined(__arm__)
+		asm volatile ("wfe" ::: "memory");
+#else
+		cpuRelax();
+#endif
+	}
+
+	/*
+		Wait policies.
+		Clock is std::chrono compatible clock (now(), duration). Bare-metal users
+		pass their own clock, i.e. based on CPU cycle counter or system timer.
+	*/
+
+	/* Pure spin, register is read back to back */
+	template<typename ClockArg = std::chrono::steady_clock>
+	struct Spin {
+		typedef ClockArg Clock;
+		typename Clock::duration timeout;
+
+		inline void pause( const uint32_t ) const {};
+	};
+
+	enum class Hint {
+		Yield,
+		WaitForEvent
+	};
+
+	/* Spin with CPU relax hint (yield/pause), or wfe between polls */
+	template<typename ClockArg = std::chrono::steady_clock, Hint hint = Hint::Yield>
+	struct Relax {
+		typedef ClockArg Clock;
+		typename Clock::duration timeout;
+
+		inline void pause( const uint32_t ) const {
+			if constexpr ( Hint::WaitForEvent == hint ) {
+				waitForEvent();
+			} else {
+				cpuRelax();
+			}
+		};
+	};
+
+	/* Exponential backoff, relax hint is repeated minSpins << poll times, but not more then maxSpins */
+	template<typename ClockArg = std::chrono::steady_clock>
+	struct Backoff {
+		typedef ClockArg Clock;
+		typename Clock::duration timeout;
+		uint32_t minSpins { 1 };
+		uint32_t maxSpins { 1024 };
+
+		inline void pause( const uint32_t poll ) const {
+			const uint32_t shift = ( poll < 31 ) ? poll : 31;
+			const uint32_t spins = ( ( maxSpins >> shift ) > minSpins ) ? ( minSpins << shift ) : maxSpins;
+			for ( uint32_t i = 0; i < spins; i++ ) {
+				cpuRelax();
+			}
+		};
+	};
+
+#if defined(__linux__)
+	/* Spin for first spinPolls polls, then sleep between polls (Linux) */
+	template<typename ClockArg = std::chrono::steady_clock>
+	struct SpinThenSleep {
+		typedef ClockArg Clock;
+		typename Clock::duration timeout;
+		uint32_t spinPolls { 64 };
+		std::chrono::nanoseconds sleep { 10000 };
+
+		inline void pause( const uint32_t poll ) const {
+			if ( poll < spinPolls ) {
+				cpuRelax();
+			} else {
+				const struct timespec ts {
+					static_cast<time_t>( sleep.count() / 1000000000 ),
+					static_cast<long>( sleep.count() % 1000000000 )
+				};
+				::nanosleep( &ts, nullptr );
+			}
+		};
+	};
+
+	enum class IrqSource {
+		/* UIO device (/dev/uioN): 32 bit event counter is read, interrupt is unmasked by write of 1 */
+		Uio,
+		/* eventfd (i.e. stands in for UIO device in tests): 64 bit counter is read */
+		EventFd
+	};
+
+	/*
+		Interrupt driven wait (Linux). Thread is blocked on file descriptor of interrupt until event or
+		the rest of timeout, then register is checked by one read. Interrupt may be shared with other
+		sources, so register is always checked before wait is done.
+		Without interrupt (fd < 0) register is polled every pollInterval.
+
+			const int fd = ::open( "/dev/uio0", O_RDWR | O_CLOEXEC );
+			auto result = Register::WaitFor< PllLockStatus, PllLockStatus::APll >(
+								PllLockStatus::APll::Type::Locked,
+								Register::Wait::Irq<>{ std::chrono::milliseconds(10), fd } );
+	*/
+	template<typename ClockArg = std::chrono::steady_clock>
+	struct Irq {
+		typedef ClockArg Clock;
+		typename Clock::duration timeout;
+		int fd { -1 };
+		IrqSource source { IrqSource::Uio };
+		std::chrono::nanoseconds pollInterval { 10000 };
+
+		inline void pause( const uint32_t poll ) const {
+			pause( poll, timeout );
+		};
+
+		inline void pause( const uint32_t, const typename Clock::duration remaining ) const {
+			if ( fd < 0 ) {
+				const std::chrono::nanoseconds sleep = ( remaining < pollInterval ) ? std::chrono::duration_cast<std::chrono::nanoseconds>( remaining ) : pollInterval;
+				const struct timespec ts {
+					static_cast<time_t>( sleep.count() / 1000000000 ),
+					static_cast<long>( sleep.count() % 1000000000 )
+				};
+				::nanosleep( &ts, nullptr );
+				return;
+			}
+			if ( IrqSource::Uio == source ) {
+				/* Interrupt is masked by UIO driver after each event. Error is ignored, when driver has no irqcontrol */
+				const int32_t unmask = 1;
+				(void)!::write( fd, &unmask, sizeof( unmask ) );
+			}
+			const auto waitMs = std::chrono::ceil<std::chrono::milliseconds>( remaining ).count();
+			struct pollfd pfd { fd, POLLIN, 0 };
+			if ( ( ::poll( &pfd, 1, ( waitMs > 0x7FFFFFFF ) ? 0x7FFFFFFF : static_cast<int>( waitMs ) ) > 0 ) && ( pfd.revents & POLLIN ) ) {
+				if ( IrqSource::Uio == source ) {
+					uint32_t events;
+					(void)!::read( fd, &events, sizeof( events ) );
+				} else {
+					uint64_t events;
+					(void)!::read( fd, &events, sizeof( events ) );
+				}
+			}
+		};
+	};
+#endif
+
+	/* Policy may accept the rest of timeout (blocking wait), otherwise poll number only */
+	template< typename Policy, typename = void >
+	struct hasTimedPause : std::false_type {};
+
+	template< typename Policy >
+	struct hasTimedPause< Policy, std::void_t< decltype( std::declval<const Policy&>().pause( uint32_t(), typename Policy::Clock::duration() ) ) > > : std::true_type {};
+
+} // Wait
+
+	/*
+		Wait until register fields are equal to values, or timeout is expired.
+		Masks are computed at compile time, as IsEqual does.
+
+		auto result = Register::WaitFor< PllLockStatus, PllLockStatus::APll, PllLockStatus::VPll >(
+							PllLockStatus::APll::Type::Locked,
+							PllLockStatus::VPll::Type::Locked,
+							Register::Wait::Backoff<>{ std::chrono::milliseconds(1) } );
+		if ( !result ) { ... }
+	*/
+	template< typename Reg, typename... Fields, typename Policy >
+	inline Wait::Result<typename Policy::Clock> WaitFor( typename Fields::Type... args, const Policy& policy ) {
+		typedef typename Policy::Clock Clock;
+		constexpr const typename Reg::Value::Type ConcatMask = getRegMaskInt< Reg, Fields...>();
+		const typename Reg::Value::Type maskedValue = getRegValueInt<Reg, Fields...>( args... ) & ConcatMask;
+		const typename Clock::time_point start = Clock::now();
+		uint32_t polls = 0;
+		while ( true ) {
+			polls++;
+			const bool done = ( ( Reg::Value::get() & ConcatMask ) == maskedValue );
+			const typename Clock::duration elapsed = Clock::now() - start;
+			if ( done ) {
+				return Wait::Result<Clock>{ Wait::Status::Done, elapsed, polls };
+			}
+			if ( elapsed >= policy.timeout ) {
+				return Wait::Result<Clock>{ Wait::Status::Timeout, elapsed, polls };
+			}
+			if constexpr ( Wait::hasTimedPause<Policy>::value ) {
+				policy.pause( polls, policy.timeout - elapsed );
+			} else {
+				policy.pause( polls );
+			}
+		}
+	}
+
+} // Register
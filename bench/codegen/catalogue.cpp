@@ -0,0 +1,185 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Catalogue of register access patterns				*/
+
+/*
+	Each pattern is one function. Object code of catalogue (and of regs.cpp) is disassembled,
+	loads, stores, barriers and instructions of each function are checked against bounds.txt
+	by check_codegen.py, for x86-64, arm and aarch64.
+	New pattern needs its bounds for each architecture ( check_codegen.py --update ).
+*/
+
+#include <RegistersClass.h>
+#include <hi3516ev200_pll_regs.h>
+
+using namespace PeriCrg;
+
+/* Register, which access must be complete ("dsb" / "sfence", "lfence") */
+struct CompleteReg : public Register::Description< 0x12010100, uint32_t, Register::DirectIo, Register::Mem32IoCompleteDescription > {
+	typedef RW< getAddress(), Field< 15, 8 > > High;
+	typedef RW< getAddress(), Field< 7, 0 > > Low;
+	typedef RS< getAddress(), Field< 31, 16 > > Reserved;
+};
+
+/* Register without ordering, bare load and store */
+struct NoSyncReg : public Register::Description< 0x12010104, uint32_t, Register::DirectIo, Register::Mem32IoNoSyncDescription > {
+	typedef RW< getAddress(), Field< 31, 16 > > High;
+	typedef RW< getAddress(), Field< 15, 0 > > Low;
+	typedef RS< getAddress() > Reserved;
+};
+
+/* Interrupt status with RW bits and write one to clear bits */
+struct IrqReg : public Register::Description< 0x12010108 > {
+	typedef RW< getAddress(), Field< 2, 0 > > Enable;
+	typedef W1C< getAddress(), Bit< 8 >, IrqReg > Done;
+	typedef W1C< getAddress(), Bit< 9 >, IrqReg > Error;
+	typedef RS< getAddress(), Field< 31, 10 >, RS< getAddress(), Field< 7, 3 > > > Reserved;
+	typedef FieldSet< Done, Error > WriteOneFields;
+};
+
+/* Interrupt clear and set register, only write one bits */
+struct IrqClearReg : public Register::Description< 0x1201010C > {
+	typedef W1C< getAddress(), Bit< 0 >, IrqClearReg > Clear;
+	typedef W1S< getAddress(), Bit< 1 >, IrqClearReg > Raise;
+	typedef RS< getAddress(), Field< 31, 2 > > Reserved;
+	typedef FieldSet< Clear, Raise > WriteOneFields;
+};
+
+extern "C" {
+
+/* All fields are written: single store, single write barrier */
+void write_all_fields() {
+	Register::Write< SocClkSel, SocClkSel::DdrClkSel, SocClkSel::CoreA7ClkSel, SocClkSel::SysApbClock, SocClkSel::SysAxiClk, SocClkSel::SysCfgClk >(
+		SocClkSel::DdrClkSel::Type::Freq300MHz, SocClkSel::CoreA7ClkSel::Type::Freq900MHz, SocClkSel::SysApbClock::Type::Freq50MHZ,
+		SocClkSel::SysAxiClk::Type::Freq200MHz, SocClkSel::SysCfgClk::Type::Freq100MHz );
+}
+
+/* VcoOutPowerDown is skipped: RMW, single read */
+void write_skipped_field() {
+	Register::Write< PllConfig1, PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown, PllConfig1::PostdivPowerDown,
+		PllConfig1::PowerDown, PllConfig1::Bypass, PllConfig1::Refdiv, PllConfig1::FBdiv >(
+		PllConfig1::FracMode::Type::IntegerMode, PllConfig1::DacPowerDown::Type::Normal, PllConfig1::FoutPowerDown::Type::Normal,
+		PllConfig1::PostdivPowerDown::Type::Normal, PllConfig1::PowerDown::Type::Normal, PllConfig1::Bypass::Type::NoBypass,
+		PllConfig1::Refdiv::Type( 1 ), PllConfig1::FBdiv::Type( 75 ) );
+}
+
+/* VcoOutPowerDown is listed: no read */
+void write_listed_field() {
+	Register::Write< PllConfig1, PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown, PllConfig1::PostdivPowerDown,
+		PllConfig1::VcoOutPowerDown, PllConfig1::PowerDown, PllConfig1::Bypass, PllConfig1::Refdiv, PllConfig1::FBdiv >(
+		PllConfig1::FracMode::Type::IntegerMode, PllConfig1::DacPowerDown::Type::Normal, PllConfig1::FoutPowerDown::Type::Normal,
+		PllConfig1::PostdivPowerDown::Type::Normal, PllConfig1::VcoOutPowerDown::Type::Normal, PllConfig1::PowerDown::Type::Normal,
+		PllConfig1::Bypass::Type::NoBypass, PllConfig1::Refdiv::Type( 1 ), PllConfig1::FBdiv::Type( 75 ) );
+}
+
+/* VcoOutPowerDown is taken from FieldDefaults: no read */
+void write_from_reset() {
+	Register::WriteFromReset< PllConfig1, PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown, PllConfig1::PostdivPowerDown,
+		PllConfig1::PowerDown, PllConfig1::Bypass, PllConfig1::Refdiv, PllConfig1::FBdiv >(
+		PllConfig1::FracMode::Type::IntegerMode, PllConfig1::DacPowerDown::Type::Normal, PllConfig1::FoutPowerDown::Type::Normal,
+		PllConfig1::PostdivPowerDown::Type::Normal, PllConfig1::PowerDown::Type::Normal, PllConfig1::Bypass::Type::NoBypass,
+		PllConfig1::Refdiv::Type( 1 ), PllConfig1::FBdiv::Type( 75 ) );
+}
+
+/* Field of runtime value, all fields are written */
+void write_runtime_values( const uint32_t frac, const uint8_t postdiv1, const uint8_t postdiv2 ) {
+	Register::Write< PllConfig0, PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( frac, postdiv1, postdiv2 );
+}
+
+/* Single bit of register: RMW */
+void set_bit() {
+	PllConfig1::Bypass::set( PllConfig1::Bypass::Type::Bypass );
+}
+
+/* Whole register value: single store */
+void set_value( const uint32_t value ) {
+	PllConfig0::Value::set( value );
+}
+
+/* W1C field of register with RW bits: RMW keeps RW bits, other write-one bits are written as 0 */
+void write_one_mixed() {
+	IrqReg::Done::set( 1 );
+}
+
+/* W1C field of register without RW bits: single store */
+void write_one_only() {
+	IrqClearReg::Clear::set( 1 );
+}
+
+/* Single read barrier and single read */
+uint32_t get_field() {
+	return static_cast<uint32_t>( PllLockStatus::APll::get() );
+}
+
+/* Both PLL lock bits are checked by single read */
+bool is_equal_two_fields() {
+	return Register::IsEqual< PllLockStatus, PllLockStatus::APll, PllLockStatus::VPll >( PllLockStatus::APll::Type::Locked, PllLockStatus::VPll::Type::Locked );
+}
+
+/* Poll loop: barrier and read inside of loop */
+void wait_locked() {
+	while ( !Register::IsEqual< PllLockStatus, PllLockStatus::APll, PllLockStatus::VPll >( PllLockStatus::APll::Type::Locked, PllLockStatus::VPll::Type::Locked ) ) {};
+}
+
+/* Two fields by single read */
+uint32_t read_two_fields() {
+	PllConfig1::Refdiv::Type refdiv;
+	PllConfig1::FBdiv::Type fbdiv;
+	Register::Read< PllConfig1, PllConfig1::Refdiv, PllConfig1::FBdiv >( refdiv, fbdiv );
+	return ( static_cast<uint32_t>( refdiv ) << 16 ) | fbdiv;
+}
+
+/* Write and two RMW: one read barrier, one write barrier */
+void transaction_bypass() {
+	Register::Transaction transaction;
+	transaction.Write< SocClkSel, SocClkSel::DdrClkSel, SocClkSel::CoreA7ClkSel, SocClkSel::SysApbClock, SocClkSel::SysAxiClk, SocClkSel::SysCfgClk >(
+		SocClkSel::DdrClkSel::Type::Freq24MHz, SocClkSel::CoreA7ClkSel::Type::Freq24MHz, SocClkSel::SysApbClock::Type::Freq24MHz,
+		SocClkSel::SysAxiClk::Type::Freq24MHz, SocClkSel::SysCfgClk::Type::Freq24MHz );
+	transaction.Set< PllConfig1::Bypass >( PllConfig1::Bypass::Type::Bypass );
+	transaction.Set< PllConfig7::Bypass >( PllConfig7::Bypass::Type::Bypass );
+}
+
+/* Register of the same layout at another address */
+void class_write( const uintptr_t address ) {
+	Register::Class< PllConfig0 > pllConfig( address );
+	pllConfig.Write< PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( 0, 2, 1 );
+}
+
+/* Block of runtime base: base + constant offset */
+void block_write( const uintptr_t base ) {
+	const CrgBlock crg( base );
+	crg.Set< PllConfig1::Bypass >( PllConfig1::Bypass::Type::Bypass );
+	crg.Write< PllConfig0, PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( 0, 2, 1 );
+}
+
+/* Two instances of array: value is computed once, single write barrier */
+void array_write_all() {
+	PllConfig0Array::WriteAll< PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >( 0, 2, 1 );
+}
+
+/* Staged fields cover register: single store */
+void staged_flush() {
+	Register::Staged< PllConfig0 >().With< PllConfig0::Frac >( 0 ).With< PllConfig0::Postdiv1 >( 2 ).With< PllConfig0::Postdiv2 >( 1 ).Flush();
+}
+
+/* Two fields of snapshot: single read */
+uint32_t snapshot_fields() {
+	const auto [ apll, vpll ] = Register::Snapshot< PllLockStatus, PllLockStatus::APll, PllLockStatus::VPll >();
+	return ( static_cast<uint32_t>( apll ) << 1 ) | static_cast<uint32_t>( vpll );
+}
+
+/* Complete ordering: store and "dsb st" ("sfence") */
+void complete_write() {
+	Register::Write< CompleteReg, CompleteReg::High, CompleteReg::Low >( 1, 2 );
+}
+
+/* Complete ordering: "dsb ld" ("lfence") and load */
+uint32_t complete_read() {
+	return CompleteReg::Low::get();
+}
+
+/* No ordering: bare load and store */
+void nosync_modify() {
+	NoSyncReg::Low::set( 0x55 );
+}
+
+}
@@ -0,0 +1,272 @@
+#!/usr/bin/env python3
+
+# (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia
+# Codegen regression check of register accesses
+
+"""
+Object files of access pattern catalogue are disassembled by objdump, and loads, stores,
+barriers and instructions of each function are checked against upper bounds.
+Any library change, which adds bus read, store, barrier or instructions to a pattern, fails the check.
+
+Usage:
+    check_codegen.py --arch arm --objdump arm-linux-gnueabihf-objdump --bounds bounds.txt catalogue.o regs.o
+    check_codegen.py --arch arm --objdump arm-linux-gnueabihf-objdump --bounds bounds.txt --update catalogue.o regs.o
+
+    --update rewrites bounds of given architecture by measured values (review the diff, before commit),
+    instruction bounds get slack of INSTRUCTION_SLACK instructions (scheduling of other compiler version).
+
+Bounds file, one line per function and architecture, "#" starts comment:
+    # arch    function              loads  stores  barriers  instructions
+    x86_64    write_all_fields      0      1       0         2
+
+Counting rules:
+    loads, stores   data memory accesses, except of stack (sp based, push, pop, call, ret)
+    barriers        dmb, dsb, isb (arm, aarch64), mfence, lfence, sfence and lock prefix (x86-64)
+    instructions    all instructions of function, literal pool data is skipped
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+ARCHS = ('x86_64', 'arm', 'aarch64')
+
+COLUMNS = ('loads', 'stores', 'barriers', 'instructions')
+
+INSTRUCTION_SLACK = 2
+
+LINE = re.compile(r'^\s*[0-9a-f]+:\s+(.*)$')
+SYMBOL = re.compile(r'^[0-9a-f]+ <([^>]+)>:$')
+
+
+def split_operands(text):
+    operands = []
+    depth = 0
+    current = ''
+    for char in text:
+        if char in '[{(':
+            depth += 1
+        elif char in ']})':
+            depth -= 1
+        if char == ',' and depth == 0:
+            operands.append(current.strip())
+            current = ''
+        else:
+            current += char
+    if current.strip():
+        operands.append(current.strip())
+    return operands
+
+
+class X86:
+    objdump_args = ['-M', 'intel']
+    barriers = ('mfence', 'lfence', 'sfence')
+    # Destination operand is only written
+    write_only = ('mov', 'movabs', 'movnti', 'movd', 'movq', 'movups', 'movaps', 'movdqu', 'movdqa', 'movss', 'movsd')
+    # Memory operands are only read
+    read_only = ('cmp', 'test', 'bt', 'push', 'movzx', 'movsx', 'movsxd', 'ucomiss', 'ucomisd')
+    stack = ('push', 'pop', 'call', 'ret', 'leave', 'enter')
+    no_access = ('lea', 'nop', 'endbr64', 'prefetcht0', 'prefetcht1', 'prefetcht2', 'prefetchnta')
+    prefixes = ('lock', 'rep', 'repz', 'repnz', 'notrack', 'bnd')
+
+    @staticmethod
+    def strip(text):
+        return text.split('#')[0].strip()
+
+    @staticmethod
+    def is_padding(mnemonic):
+        return ('nop' in mnemonic) or mnemonic == 'int3' or mnemonic.startswith('data16') or mnemonic.startswith('cs')
+
+    @classmethod
+    def count(cls, mnemonic, operands, result):
+        if mnemonic in cls.prefixes and operands:
+            if mnemonic == 'lock':
+                result['barriers'] += 1
+            parts = operands.split(None, 1)
+            mnemonic = parts[0]
+            operands = parts[1] if len(parts) > 1 else ''
+        if mnemonic in cls.barriers:
+            result['barriers'] += 1
+            return
+        if mnemonic in cls.stack or mnemonic in cls.no_access or cls.is_padding(mnemonic):
+            return
+        args = split_operands(operands)
+        memory = [index for index, arg in enumerate(args) if ('[' in arg or 'PTR' in arg) and not re.search(r'\[(rsp|rbp|esp|ebp)\b', arg)]
+        if not memory:
+            return
+        if mnemonic in cls.read_only:
+            result['loads'] += 1
+        elif mnemonic in ('xchg', 'cmpxchg', 'xadd') or mnemonic.startswith('cmpxchg'):
+            result['loads'] += 1
+            result['stores'] += 1
+        elif 0 in memory:
+            if mnemonic in cls.write_only or mnemonic.startswith('set') or mnemonic.startswith('stos'):
+                result['stores'] += 1
+            else:
+                result['loads'] += 1
+                result['stores'] += 1
+        else:
+            result['loads'] += 1
+
+
+class Arm:
+    objdump_args = []
+    barriers = ('dmb', 'dsb', 'isb')
+
+    @staticmethod
+    def strip(text):
+        return re.split(r'[;@]', text)[0].strip()
+
+    @staticmethod
+    def is_padding(mnemonic):
+        return mnemonic == 'nop'
+
+    @classmethod
+    def count(cls, mnemonic, operands, result):
+        base = mnemonic.split('.')[0]
+        if base in cls.barriers:
+            result['barriers'] += 1
+            return
+        if base in ('push', 'pop', 'vpush', 'vpop'):
+            return
+        if re.search(r'\[sp\b', operands) or re.match(r'sp!?,', operands):
+            return
+        if base.startswith('ld') or base.startswith('vld'):
+            result['loads'] += 1
+        elif base.startswith('st') or base.startswith('vst'):
+            result['stores'] += 1
+        elif base.startswith('swp') or base.startswith('cas'):
+            result['loads'] += 1
+            result['stores'] += 1
+
+
+class AArch64(Arm):
+    @staticmethod
+    def strip(text):
+        return text.split('//')[0].strip()
+
+
+TARGETS = {'x86_64': X86, 'arm': Arm, 'aarch64': AArch64}
+
+
+def disassemble(objdump, target, objects):
+    functions = {}
+    for path in objects:
+        output = subprocess.run([objdump, '-d', '-w', '--no-show-raw-insn'] + target.objdump_args + [path],
+                                check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+        name = None
+        for line in output.splitlines():
+            symbol = SYMBOL.match(line.strip())
+            if symbol:
+                name = symbol.group(1)
+                functions[name] = []
+                continue
+            match = LINE.match(line)
+            if not match or name is None:
+                continue
+            text = target.strip(match.group(1))
+            if not text or text.startswith('.') or text.startswith('(bad)'):
+                continue
+            parts = text.split(None, 1)
+            functions[name].append((parts[0], parts[1] if len(parts) > 1 else ''))
+    return functions
+
+
+def measure(target, instructions):
+    # Alignment padding after the last instruction isn't a part of function
+    while instructions and target.is_padding(instructions[-1][0]):
+        instructions = instructions[:-1]
+    result = dict.fromkeys(COLUMNS, 0)
+    for mnemonic, operands in instructions:
+        result['instructions'] += 1
+        target.count(mnemonic, operands, result)
+    return result
+
+
+def load_bounds(path):
+    bounds = {}
+    lines = []
+    with open(path) as source:
+        for number, line in enumerate(source, 1):
+            lines.append(line.rstrip('\n'))
+            words = line.split('#')[0].split()
+            if not words:
+                continue
+            if len(words) != 2 + len(COLUMNS) or words[0] not in ARCHS:
+                raise SystemExit('{}:{}: expected "arch function {}"'.format(path, number, ' '.join(COLUMNS)))
+            bounds[(words[0], words[1])] = dict(zip(COLUMNS, (int(word) for word in words[2:])))
+    return bounds, lines
+
+
+def update_bounds(path, lines, bounds, arch, measured):
+    header = []
+    for line in lines:
+        if line.split('#')[0].strip():
+            break
+        header.append(line)
+    bounds = {key: value for key, value in bounds.items() if key[0] != arch}
+    bounds.update({(arch, name): dict(values, instructions=values['instructions'] + INSTRUCTION_SLACK) for name, values in measured.items()})
+    text = header
+    for group in ARCHS:
+        names = sorted(name for key, name in bounds if key == group)
+        if names:
+            for name in names:
+                text.append('{:<8}  {:<24}  {:>5}  {:>6}  {:>8}  {:>12}'.format(group, name, *(bounds[(group, name)][column] for column in COLUMNS)))
+            text.append('')
+    with open(path, 'w') as target:
+        target.write('\n'.join(text))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check loads, stores, barriers and instructions of register access patterns')
+    parser.add_argument('objects', nargs='+', help='object files of catalogue')
+    parser.add_argument('--arch', choices=ARCHS, required=True)
+    parser.add_argument('--objdump', default='objdump', help='objdump of target architecture')
+    parser.add_argument('--bounds', required=True, help='bounds file')
+    parser.add_argument('--update', action='store_true', help='rewrite bounds of architecture by measured values')
+    parser.add_argument('--report', help='write report into file too')
+    args = parser.parse_args()
+
+    target = TARGETS[args.arch]
+    measured = {name: measure(target, code) for name, code in disassemble(args.objdump, target, args.objects).items()}
+    bounds, lines = load_bounds(args.bounds)
+
+    if args.update:
+        update_bounds(args.bounds, lines, bounds, args.arch, measured)
+        print('{}: {} bounds of {} are updated'.format(args.bounds, len(measured), args.arch))
+        return 0
+
+    report = ['{:<28} {}'.format('function (' + args.arch + ')', '  '.join('{:>14}'.format(column) for column in COLUMNS))]
+    failures = 0
+    for name in sorted(measured):
+        bound = bounds.get((args.arch, name))
+        if bound is None:
+            report.append('{:<28} no bounds, please add them ( --update )'.format(name))
+            failures += 1
+            continue
+        cells = []
+        exceeded = False
+        for column in COLUMNS:
+            cells.append('{:>14}'.format('{} / {}'.format(measured[name][column], bound[column])))
+            exceeded = exceeded or measured[name][column] > bound[column]
+        report.append('{:<28} {}{}'.format(name, '  '.join(cells), '  EXCEEDED' if exceeded else ''))
+        failures += exceeded
+    for arch, name in sorted(bounds):
+        if arch == args.arch and name not in measured:
+            report.append('{:<28} function is not found, please remove its bounds'.format(name))
+            failures += 1
+
+    text = '\n'.join(report) + '\n'
+    sys.stdout.write(text)
+    if failures:
+        sys.stdout.write('{} function(s) of {} failed codegen check\n'.format(failures, args.arch))
+        return 1
+    if args.report:
+        with open(args.report, 'w') as target:
+            target.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
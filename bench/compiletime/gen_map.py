@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+# (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia
+# Synthetic register map of compile time benchmark
+
+"""
+Register map of given size is described by CSV and generated by tools/regmapgen.py, as real maps are.
+Each register has "fields" RW fields ( 2 bits each ), translation unit writes all fields of each
+register by Register::Write and reads them back by Register::Read.
+
+Usage:
+    gen_map.py --registers 5000 --fields 12 -o build/compiletime
+    Output is <output>/synthetic_regs.h (namespace Synthetic) and <output>/synthetic_map.cpp
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+BASE = 0x40000000
+FIELD_BITS = 2
+
+
+def write_csv(path, registers, fields):
+    with open(path, 'w') as target:
+        target.write('peripheral,base,register,offset,size,reset,field,msb,lsb,access,description\n')
+        for reg in range(registers):
+            for field in range(fields):
+                lsb = field * FIELD_BITS
+                target.write('Synthetic,{:#x},R{},{:#x},32,,F{},{},{},RW,Field {} of register {}\n'.format(
+                    BASE, reg, reg * 4, field, lsb + FIELD_BITS - 1, lsb, field, reg))
+
+
+def write_source(path, registers, fields):
+    names = ['F{}'.format(field) for field in range(fields)]
+    lines = [
+        '/* Generated by gen_map.py: {} registers, {} fields each */'.format(registers, fields),
+        '',
+        '#include <synthetic_regs.h>',
+        '',
+        'using namespace Synthetic;',
+        '',
+    ]
+    for reg in range(registers):
+        name = 'R{}'.format(reg)
+        field_list = ', '.join('{}::{}'.format(name, field) for field in names)
+        lines.append('void write{}( const uint32_t value ) {{'.format(name))
+        lines.append('\tRegister::Write< {}, {} >( {} );'.format(name, field_list, ', '.join('value' for _ in names)))
+        lines.append('}')
+        lines.append('uint32_t read{}() {{'.format(name))
+        lines.append('\t{}::{}::Type {};'.format(name, names[0], ', '.join('v{}'.format(index) for index in range(fields))))
+        lines.append('\tRegister::Read< {}, {} >( {} );'.format(name, field_list, ', '.join('v{}'.format(index) for index in range(fields))))
+        lines.append('\treturn {};'.format(' + '.join('v{}'.format(index) for index in range(fields))))
+        lines.append('}')
+    lines.append('')
+    with open(path, 'w') as target:
+        target.write('\n'.join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate synthetic register map of compile time benchmark')
+    parser.add_argument('--registers', type=int, default=5000)
+    parser.add_argument('--fields', type=int, default=12, help='RW fields of register (2 bits each)')
+    parser.add_argument('-o', '--output', default='.')
+    parser.add_argument('--regmapgen', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', 'tools', 'regmapgen.py'))
+    args = parser.parse_args()
+    if args.fields * FIELD_BITS > 32:
+        raise SystemExit('No more then {} fields of 32-bit register'.format(32 // FIELD_BITS))
+
+    os.makedirs(args.output, exist_ok=True)
+    csv_path = os.path.join(args.output, 'synthetic.csv')
+    write_csv(csv_path, args.registers, args.fields)
+    subprocess.run([sys.executable, args.regmapgen, csv_path, '-o', args.output], check=True, stdout=subprocess.DEVNULL)
+    write_source(os.path.join(args.output, 'synthetic_map.cpp'), args.registers, args.fields)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
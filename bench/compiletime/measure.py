@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+# (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia
+# Build time and peak memory of compile command
+
+"""
+Compile command is run once, its wall time and peak resident memory (of compiler processes) are printed,
+and appended to results file as one line:
+    <label>  <seconds>  <peak MB>
+
+Usage:
+    measure.py --label "5000 registers -O0" --results compiletime.txt -- g++ -std=c++17 -O0 -c synthetic_map.cpp
+"""
+
+import argparse
+import resource
+import subprocess
+import sys
+import time
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Measure build time and peak memory of command')
+    parser.add_argument('--label', default='build')
+    parser.add_argument('--results', help='append result line to file')
+    parser.add_argument('command', nargs=argparse.REMAINDER)
+    args = parser.parse_args()
+    command = args.command[1:] if args.command and args.command[0] == '--' else args.command
+    if not command:
+        raise SystemExit('Command is not given')
+
+    start = time.monotonic()
+    status = subprocess.run(command).returncode
+    seconds = time.monotonic() - start
+    if status != 0:
+        return status
+    # ru_maxrss of children is KB on Linux: the biggest process, i.e. cc1plus
+    peak = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss / 1024.0
+
+    line = '{:<32} {:>10.2f} s {:>10.1f} MB'.format(args.label, seconds, peak)
+    print(line)
+    if args.results:
+        with open(args.results, 'a') as target:
+            target.write(line + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
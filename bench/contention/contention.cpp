@@ -0,0 +1,158 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Contention benchmark of read-modify-write concurrency policies */
+
+/*
+	Threads modify own 8-bit field of the same register, register is placed in memory (Block base).
+	Each thread checks before its next update, that its previous value is still there,
+	otherwise update was lost (another thread has written back stale value of the field).
+	Policies are compared by time of one update, and by number of lost updates:
+		None		- plain RMW, updates are lost under contention
+		IrqMask		- bare-metal only (interrupt masking faults in user mode), single context is measured,
+					  build with REGS_CONTENTION_BARE_METAL defined
+		Exclusive	- compare-exchange loop
+		StripedLock	- spinlock of register stripe
+
+	contention [--threads N] [--iterations N]
+	Exit code is not 0, when Exclusive or StripedLock lose an update.
+*/
+
+#include <RegistersClass.h>
+#include <MemIoRmw.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+	constexpr const Register::AddressType RegAddress = 0x1000;
+	constexpr const size_t MaxThreads = 4;
+
+	/* Register with four 8-bit fields, RMW is protected by policy */
+	template< typename Policy >
+	struct SharedReg : public Register::Description< RegAddress, uint32_t, Register::DirectIo, Register::Mem32IoRmwDescription< Policy > > {
+		typedef Register::Description< RegAddress, uint32_t, Register::DirectIo, Register::Mem32IoRmwDescription< Policy > > Base;
+		template< size_t lane >
+		using Lane = Register::RW< RegAddress, Register::Field< lane * 8 + 7, lane * 8, uint8_t >, Base >;
+		typedef Register::RS< RegAddress > Reserved;
+	};
+
+	typedef Register::Block< RegAddress, 4 > RegBlock;
+
+	struct Result {
+		double nsPerUpdate;
+		uint64_t lost;
+	};
+
+	template< typename Policy, size_t lane >
+	uint64_t updateLoop( const RegBlock& block, const uint32_t iterations ) {
+		typedef typename SharedReg< Policy >::template Lane< lane > Field;
+		uint64_t lost = 0;
+		uint8_t previous = 0;
+		for ( uint32_t index = 1; index <= iterations; index++ ) {
+			if ( block.Get< SharedReg< Policy >, Field >() != previous ) {
+				lost++;
+			}
+			previous = static_cast<uint8_t>( index );
+			block.Set< Field >( previous );
+		}
+		return lost;
+	}
+
+	template< typename Policy >
+	uint64_t runLane( const RegBlock& block, const size_t lane, const uint32_t iterations ) {
+		switch ( lane ) {
+			case 0: return updateLoop< Policy, 0 >( block, iterations );
+			case 1: return updateLoop< Policy, 1 >( block, iterations );
+			case 2: return updateLoop< Policy, 2 >( block, iterations );
+			default: return updateLoop< Policy, 3 >( block, iterations );
+		}
+	}
+
+	template< typename Policy >
+	Result measure( const size_t threads, const uint32_t iterations ) {
+		alignas(64) static uint32_t memory;
+		memory = 0;
+		const RegBlock block( &memory );
+		std::atomic<size_t> ready { 0 };
+		std::vector< uint64_t > lost( threads, 0 );
+		std::vector< std::thread > workers;
+		for ( size_t lane = 0; lane < threads; lane++ ) {
+			workers.emplace_back( [ &, lane ]() {
+				ready.fetch_add( 1 );
+				while ( ready.load() != threads + 1 ) {};
+				lost[ lane ] = runLane< Policy >( block, lane, iterations );
+			} );
+		}
+		while ( ready.load() != threads ) {};
+		const auto start = std::chrono::steady_clock::now();
+		ready.fetch_add( 1 );
+		for ( std::thread& worker : workers ) {
+			worker.join();
+		}
+		const std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+		Result result { elapsed.count() / ( static_cast<double>( threads ) * iterations ), 0 };
+		for ( const uint64_t count : lost ) {
+			result.lost += count;
+		}
+		return result;
+	}
+
+	/* Single context, there is no contention: cost of policy itself */
+	template< typename Policy >
+	double measureSingle( const uint32_t iterations ) {
+		alignas(64) static uint32_t memory;
+		memory = 0;
+		const RegBlock block( &memory );
+		const auto start = std::chrono::steady_clock::now();
+		updateLoop< Policy, 0 >( block, iterations );
+		const std::chrono::duration< double, std::nano > elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / iterations;
+	}
+
+	void report( const char* const name, const double single, const Result& result ) {
+		std::printf( "%-14s %12.1f %12.1f %12llu\n", name, single, result.nsPerUpdate, static_cast<unsigned long long>( result.lost ) );
+	}
+
+} // namespace
+
+int main( int argc, char** argv ) {
+	size_t threads = MaxThreads;
+	uint32_t iterations = 10000000;
+	for ( int index = 1; index + 1 < argc; index += 2 ) {
+		if ( 0 == std::strcmp( argv[ index ], "--threads" ) ) {
+			threads = static_cast<size_t>( std::strtoul( argv[ index + 1 ], nullptr, 0 ) );
+		} else if ( 0 == std::strcmp( argv[ index ], "--iterations" ) ) {
+			iterations = static_cast<uint32_t>( std::strtoul( argv[ index + 1 ], nullptr, 0 ) );
+		}
+	}
+	if ( ( threads == 0 ) || ( threads > MaxThreads ) ) {
+		std::fprintf( stderr, "Number of threads is 1..%zu\n", MaxThreads );
+		return 2;
+	}
+
+	std::printf( "threads %zu, iterations %u, cpus %u\n", threads, iterations, std::thread::hardware_concurrency() );
+	std::printf( "%-14s %12s %12s %12s\n", "policy", "single, ns", "shared, ns", "lost" );
+
+	const Result none = measure< Register::Rmw::None >( threads, iterations );
+	report( "None", measureSingle< Register::Rmw::None >( iterations ), none );
+#if defined(REGS_CONTENTION_BARE_METAL)
+	std::printf( "%-14s %12.1f %12s %12s\n", "IrqMask", measureSingle< Register::Rmw::IrqMask >( iterations ), "-", "-" );
+#else
+	std::printf( "%-14s %12s %12s %12s  (bare-metal only)\n", "IrqMask", "-", "-", "-" );
+#endif
+	const Result exclusive = measure< Register::Rmw::Exclusive >( threads, iterations );
+	report( "Exclusive", measureSingle< Register::Rmw::Exclusive >( iterations ), exclusive );
+	const Result striped = measure< Register::Rmw::StripedLock<> >( threads, iterations );
+	report( "StripedLock", measureSingle< Register::Rmw::StripedLock<> >( iterations ), striped );
+
+	if ( ( exclusive.lost != 0 ) || ( striped.lost != 0 ) ) {
+		std::printf( "Protected policy has lost updates\n" );
+		return 1;
+	}
+	return 0;
+}
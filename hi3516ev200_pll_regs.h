@@ -9,10 +9,32 @@
 #include <RegistersClass.h>
 
 
+/*
+        Register access backend of PERI_CRG block.
+        Bare-metal default is direct access. Linux userspace may define it before
+        include of this header, i.e. mapped window (see MemIoLinux.h):
+        #define PERI_CRG_IO Register::Linux::MappedIo< Register::Linux::Window< 0x12010000, 0x1000 > >
+*/
+#ifndef PERI_CRG_IO
+#define PERI_CRG_IO Register::DirectIo
+#endif
+
 namespace PeriCrg {
 
 using namespace Register;
 
+template<AddressType address, typename RegValueType = DefaultValueType, typename IoDescription = MemIoDescription<RegValueType> >
+using Description = Register::Description< address, RegValueType, PERI_CRG_IO, IoDescription >;
+
+/*
+        PLL configuration, clock selection and PLL lock status registers switch clock of CPU and buses.
+        Their access must be complete before next instruction ( "dsb", Ordering::Complete ): code after
+        clock switch runs on new clock, and PLL lock is polled, when PLL configuration is complete.
+        Default Ordering::Device ( "dmb osh" ) only orders accesses of device, it is enough for other registers.
+*/
+template<AddressType address>
+using ClockDescription = Description< address, uint32_t, Mem32IoCompleteDescription >;
+
 /*
         HiSilicon DataSheet.
         Fbdiv: integer part of multiplier coefficient;
@@ -24,7 +46,7 @@ using namespace Register;
 */
 
 // PERI_CRG_PLL0/PERI_CRG_PLL6 is APLL/VPLL configuration register 0/6.
-struct PllConfig0 : public Description<0x12010000> {
+struct PllConfig0 : public ClockDescription<0x12010000> {
         // [30:28] The second stage of the APLL outputs the frequency division factor.
         typedef RW< getAddress(), Field< 30, 28, uint8_t>> Postdiv2;
         // [26:24] APLL first-stage output frequency division coefficient.
@@ -32,12 +54,11 @@ struct PllConfig0 : public Description<0x12010000> {
         // [23:0]  The fractional part of the APLL multiplier coefficient.
         typedef RW< getAddress(), Field< 23,  0, uint32_t>> Frac;
         // [27], [31] - Reservied fields
-        typedef RS< getAddress(), Field< 27, 27 >, 
-                RS< getAddress(), Field< 31, 31> > > Reserved;
+        typedef RS< getAddress(), Field< 27, 27 >, Field< 31, 31 > > Reserved;
 };
 
 // PERI_CRG_PLL1/PERI_CRG_PLL7 is APLL/VPLL configuration register 1/7.
-struct PllConfig1 :  public Description<0x12010004> {
+struct PllConfig1 :  public ClockDescription<0x12010004> {
         // [26]    APLL clock divider bypass (bypass) control system.
         // 0: no bypass; 1: Bypass;
         enum class TBypass {
@@ -102,13 +123,15 @@ struct PllConfig1 :  public Description<0x12010004> {
         typedef RW< getAddress(), Field < 11, 0, uint16_t>> FBdiv;
 
         // [31:27], [19:18] Reserved
-        typedef RS< getAddress(), Field<19, 18>,
-                RS< getAddress(), Field<31,27> > > Reserved;
+        typedef RS< getAddress(), Field<19, 18>, Field<31,27> > Reserved;
+
+        // Defaults of fields, which are omitted by WriteFromReset
+        typedef Defaults< Default< VcoOutPowerDown, TVcoOutputPowerDown::Normal > > FieldDefaults;
  
 };
 
 // PERI_CRG_PLL0/PERI_CRG_PLL6 is APLL/VPLL configuration register 0/6.
-struct PllConfig6 : public Description< 0x12010018 > {
+struct PllConfig6 : public ClockDescription< 0x12010018 > {
         // [30:28] The second stage of the APLL outputs the frequency division factor.
         typedef RW< getAddress(), Field< 30, 28, uint8_t>> Postdiv2;
         // [26:24] APLL first-stage output frequency division coefficient.
@@ -116,12 +139,11 @@ struct PllConfig6 : public Description< 0x12010018 > {
         // [23:0]  The fractional part of the APLL multiplier coefficient.
         typedef RW< getAddress(), Field< 23,  0, uint32_t>> Frac;
         // [27], [31] - Reservied fields
-        typedef RS< getAddress(), Field< 27, 27 >, 
-                RS< getAddress(), Field< 31, 31> > > Reserved;
+        typedef RS< getAddress(), Field< 27, 27 >, Field< 31, 31 > > Reserved;
 };
 
 // PERI_CRG_PLL1/PERI_CRG_PLL7 is APLL/VPLL configuration register 1/7.
-struct PllConfig7 :  public Description< 0x1201001C > {
+struct PllConfig7 :  public ClockDescription< 0x1201001C > {
         // [26]    APLL clock divider bypass (bypass) control system.
         // 0: no bypass; 1: Bypass;
         enum class TBypass {
@@ -186,8 +208,7 @@ struct PllConfig7 :  public Description< 0x1201001C > {
         typedef RW< getAddress(), Field < 11, 0, uint16_t>> FBdiv;
         
         // [31:27], [19:18] Reserved
-        typedef RS< getAddress(), Field<19, 18>,
-                RS< getAddress(), Field<31,27> > > Reserved;
+        typedef RS< getAddress(), Field<19, 18>, Field<31,27> > Reserved;
  
 };
 
@@ -382,7 +403,7 @@ struct DdrClkAndRst : public Register::Description<RegAccessConfig, 0x1201007C>
                 Disable,
                 Enable
         };
-        struct DdrCfgClk : public Bit<5,TDdrCfgClk> {};
+        struct DdrCfgClk : public Bit<4,TDdrCfgClk> {};
 
         // [2] DDR PHY PLL spread spectrum clock bypass configuration register
         // 0: bypass the spread spectrum clock of DDR PHY PLL;
@@ -416,7 +437,7 @@ struct DdrClkAndRst : public Register::Description<RegAccessConfig, 0x1201007C>
 #endif
 
 // PERI_CRG32 is the SOC clock selection register.
-struct SocClkSel : public Register::Description< 0x12010080 > {
+struct SocClkSel : public ClockDescription< 0x12010080 > {
         // [10] SYSAPB clock selection.
         // 0: 24MHz; 1: 50MHz
         enum class TSysApbClock {
@@ -461,10 +482,10 @@ struct SocClkSel : public Register::Description< 0x12010080 > {
         typedef RW< getAddress(), Field<1,0, TCoreA7ClkSel>> CoreA7ClkSel;
 
         // [31:11], [9], [7], [2] - Reserved
-        typedef RS< getAddress(), Bit<2>,
-                RS< getAddress(), Bit<7>,
-                RS< getAddress(), Bit<9>,
-                RS< getAddress(), Field<31,11> >>>> Reserved;
+        typedef RS< getAddress(), Bit<2>, Bit<7>, Bit<9>, Field<31,11> > Reserved;
+
+        // Clocks are selected from PLL outputs, PLLs are restored first ( see Register::Context )
+        typedef Dependencies< PllConfig0, PllConfig1, PllConfig6, PllConfig7 > RestoreAfter;
 };
 
 
@@ -519,14 +540,17 @@ struct MediaBlockFreq : public Register::Description<RegAccessConfig, 0x120100A0
 #endif
 
 // PERI_CRG_PLL122 It is the PLL LOCK status register.
-struct PllLockStatus : public Register::Description< 0x120101E8 > {
+struct PllLockStatus : public ClockDescription< 0x120101E8 > {
+        // Status register, it is updated by hardware
+        static constexpr const bool HardwareUpdated = true;
+
         // [2] VPLL LOCK state.
         // 0: Unlock; 1: Locked.
         enum class TVPll {
                 Unlock,
                 Locked
         };
-        typedef RW< getAddress(), Bit<2, TVPll>> VPll;
+        typedef RO< getAddress(), Bit<2, TVPll>> VPll;
         
         // [0] APLL LOCK state.
         // 0: Unlock; 1: Locked.
@@ -534,13 +558,23 @@ struct PllLockStatus : public Register::Description< 0x120101E8 > {
                 Unlock,
                 Locked
         };
-        typedef RW< getAddress(), Bit<0, TAPll>> APll;
+        typedef RO< getAddress(), Bit<0, TAPll>> APll;
 
         // [31:3], [1] - Reserved
-        typedef RS< getAddress(), Bit<1>,
-                RS< getAddress(), Field<31,3>>> Reserved;
+        typedef RS< getAddress(), Bit<1>, Field<31,3> > Reserved;
+
+        // Lock state isn't saved and restored ( see Register::Context )
+        typedef FieldSet< VPll, APll > ReadOnlyFields;
 
 };
 
+// APLL/VPLL configuration registers 0/6 and 1/7, the same layout with stride 0x18
+typedef Array< PllConfig0, 0x18, 2 > PllConfig0Array;
+typedef Array< PllConfig1, 0x18, 2 > PllConfig1Array;
+
+// PERI_CRG block, registers are accessed by offset from runtime base (i.e. another instance), base is in address space of PERI_CRG_IO.
+// Mapped Linux window is accessed by Register::Linux::MappedBlock, it resolves mapped base once.
+typedef Block< 0x12010000, 0x1000 > CrgBlock;
+
 } // namespace PeriCrg
 
@@ -3,6 +3,9 @@
 /* (C) Evgeny Sobolev 09.02.1984 y.b, VRN, Russia, 	*/
 /* At 24.02.2023 					*/
 /* New description testing */
+/* Listings below are 32-bit arm code (ARMv8 "ld" / "st" barrier options). PLL, clock	*/
+/* selection and lock status registers are Ordering::Complete ( ClockDescription ),	*/
+/* so their barriers are "dsb ld" / "dsb st", not default "dmb osh" of Ordering::Device.	*/
 
 #include <RegistersClass.h>
 #include <hi3516ev200_pll_regs.h>
@@ -23,48 +26,42 @@ void pllInit() {
 		Step 4. If the PLL LOCK register is in the LOCK state, the PLL configuration is complete, otherwise go back to step 3 until the PLL LOCK register is in the LOCK state.
 	*/
 
-	// Switch all clocks to 24MHz clock
-	Register::Write< SocClkSel,
-			SocClkSel::DdrClkSel,
-			SocClkSel::CoreA7ClkSel,
-			SocClkSel::SysApbClock,
-			SocClkSel::SysAxiClk,
-			SocClkSel::SysCfgClk
-			 > (
-				SocClkSel::DdrClkSel::Type::Freq24MHz,
-				SocClkSel::CoreA7ClkSel::Type::Freq24MHz,
-				SocClkSel::SysApbClock::Type::Freq24MHz,
-				SocClkSel::SysAxiClk::Type::Freq24MHz,
-				SocClkSel::SysCfgClk::Type::Freq24MHz
-			);
-/*
-;Prepare, load Register(RegisterBase) addresss
-14000a88:       e3a03000        mov     r3, #0				; 0x0000
-14000a8c:       e3413201        movt    r3, #4609       	; 0x1201, i.e. R3 <= 0x12010000
+	{
+		// Switch all clocks to 24MHz clock and put both PLLs to bypass mode.
+		// Writes are issued in program order, with one write barrier at the end of scope.
+		Register::Transaction transaction;
 
-14000a90:       e3a02000        mov     r2, #0				; R2 <= 0, i.e all clocks is 24MHz
-14000a94:       e5832080        str     r2, [r3, #128]  	; [0x12010000] <= 0
-14000a98:       f57ff04e        dsb     st					; Write bariler instruction
-*/	
+		transaction.Write< SocClkSel,
+				SocClkSel::DdrClkSel,
+				SocClkSel::CoreA7ClkSel,
+				SocClkSel::SysApbClock,
+				SocClkSel::SysAxiClk,
+				SocClkSel::SysCfgClk
+				 > (
+					SocClkSel::DdrClkSel::Type::Freq24MHz,
+					SocClkSel::CoreA7ClkSel::Type::Freq24MHz,
+					SocClkSel::SysApbClock::Type::Freq24MHz,
+					SocClkSel::SysAxiClk::Type::Freq24MHz,
+					SocClkSel::SysCfgClk::Type::Freq24MHz
+				);
 
-	/* Setup PLLA - bypass mode */
-	PllConfig1::Bypass::set(PllConfig1::Bypass::Type::Bypass);
-/*
-14000a9c:       f57ff04d        dsb     ld						; Read barier
-14000aa0:       e5932004        ldr     r2, [r3, #4]			; Load register value R2 <= [0x12010004]
-14000aa4:       e3822301        orr     r2, r2, #67108864       ; R2 |= 0x4000000, i.e. set Bypass
-14000aa8:       e5832004        str     r2, [r3, #4]			; [0x12010004] <= R2, i.e. Write register
-14000aac:       f57ff04e        dsb     st						; Write barier
-*/
+		/* Setup PLLA - bypass mode */
+		transaction.Set<PllConfig1::Bypass>(PllConfig1::Bypass::Type::Bypass);
 
-	/* Setup PLLV - bypass mode */
-	PllConfig7::Bypass::set(PllConfig7::Bypass::Type::Bypass);
+		/* Setup PLLV - bypass mode */
+		transaction.Set<PllConfig7::Bypass>(PllConfig7::Bypass::Type::Bypass);
+	}
 /*
-14000ab0:       f57ff04d        dsb     ld						; Read barier
-14000ab4:       e593201c        ldr     r2, [r3, #28]			; Load register value R2 <= [0x1201001C]
-14000ab8:       e3822301        orr     r2, r2, #67108864       ; R2 |= 0x4000000, i.e. set Bypass
-14000abc:       e583201c        str     r2, [r3, #28]			; [0x1201001C] <= R2, i.e. Write register
-14000ac0:       f57ff04e        dsb     st						; Write barier
+; x86-64 listing (GCC 12, -O2, objdump -d -M intel), "lfence" / "sfence" are "dsb ld" / "dsb st" of arm
+   0:	mov    DWORD PTR ds:0x12010080,0x0		; [0x12010080] <= 0, i.e all clocks is 24MHz, no barrier after write
+   b:	lfence								; Read barier, only before the first read of transaction
+   e:	mov    eax,DWORD PTR ds:0x12010004		; Load register value EAX <= [0x12010004]
+  15:	or     eax,0x4000000					; EAX |= 0x4000000, i.e. set Bypass
+  1a:	mov    DWORD PTR ds:0x12010004,eax		; [0x12010004] <= EAX
+  21:	mov    eax,DWORD PTR ds:0x1201001c		; Load register value EAX <= [0x1201001C]
+  28:	or     eax,0x4000000					; EAX |= 0x4000000, i.e. set Bypass
+  2d:	mov    DWORD PTR ds:0x1201001c,eax		; [0x1201001C] <= EAX
+  34:	sfence								; The only write barier, at the end of transaction
 */
 
 #if 1
@@ -272,3 +269,37 @@ while( PllLockStatus::APll::Type::Locked != PllLockStatus::APll::get() ) {};
 
 }
 
+/*
+	Compile-time checks of access path selection of listings above (see Register::AccessCost).
+	Generated code of pllInit() is checked by bench/codegen, against bounds of each architecture.
+*/
+static_assert( Register::getWriteCost< SocClkSel,
+			SocClkSel::DdrClkSel, SocClkSel::CoreA7ClkSel, SocClkSel::SysApbClock,
+			SocClkSel::SysAxiClk, SocClkSel::SysCfgClk >().reads == 0, "All SocClkSel fields are written, don't read register" );
+
+static_assert( Register::getSetCost< PllConfig1::Bypass >().reads == 1, "Bypass is single bit, RMW is required" );
+static_assert( Register::getSetCost< PllConfig1::Bypass >().barriers == 2, "RMW has read and write barrier" );
+
+static_assert( Register::getWriteCost< PllConfig1,
+			PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown,
+			PllConfig1::PostdivPowerDown, PllConfig1::PowerDown, PllConfig1::Bypass,
+			PllConfig1::Refdiv, PllConfig1::FBdiv >().reads == 1, "VcoOutPowerDown is skipped, register is read" );
+
+static_assert( Register::getWriteCost< PllConfig1,
+			PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown,
+			PllConfig1::PostdivPowerDown, PllConfig1::VcoOutPowerDown, PllConfig1::PowerDown,
+			PllConfig1::Bypass, PllConfig1::Refdiv, PllConfig1::FBdiv >().reads == 0, "All PllConfig1 fields are written, don't read register" );
+
+static_assert( Register::getWriteFromResetCost< PllConfig1,
+			PllConfig1::FracMode, PllConfig1::DacPowerDown, PllConfig1::FoutPowerDown,
+			PllConfig1::PostdivPowerDown, PllConfig1::PowerDown, PllConfig1::Bypass,
+			PllConfig1::Refdiv, PllConfig1::FBdiv >().reads == 0, "VcoOutPowerDown is taken from FieldDefaults, don't read register" );
+
+static_assert( Register::getWriteCost< PllConfig0,
+			PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >().reads == 0, "All PllConfig0 fields are written, don't read register" );
+
+static_assert( Register::getWriteCost< PllConfig0,
+			PllConfig0::Frac, PllConfig0::Postdiv1, PllConfig0::Postdiv2 >().barriers == 1, "Single write barrier" );
+
+static_assert( Register::getIsEqualCost< PllLockStatus,
+			PllLockStatus::APll, PllLockStatus::VPll >().reads == 1, "Both PLL lock bits are checked by single read" );
@@ -0,0 +1,43 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Checks of behavioral tests						*/
+
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+
+/*
+	Failed check is printed and counted, test goes on, so one run shows all failures.
+	main() returns Test::result(): 0 - passed, 1 - there are failed checks (ctest failure).
+*/
+namespace Test {
+
+	inline uint32_t& failures() {
+		static uint32_t count = 0;
+		return count;
+	}
+
+	inline void check( const bool condition, const char* const expression, const char* const file, const int line ) {
+		if ( !condition ) {
+			failures()++;
+			std::printf( "%s:%d: check failed: %s\n", file, line, expression );
+		}
+	}
+
+	/* Test group is printed, so failure is found in output */
+	inline void group( const char* const name ) {
+		std::printf( "%s\n", name );
+	}
+
+	inline int result() {
+		if ( 0 != failures() ) {
+			std::printf( "%u checks failed\n", failures() );
+			return 1;
+		}
+		std::printf( "passed\n" );
+		return 0;
+	}
+
+} // Test
+
+#define CHECK( condition ) Test::check( static_cast<bool>( condition ), #condition, __FILE__, __LINE__ )
@@ -0,0 +1,151 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Behavioral test of coroutine waits, it is built as C++20		*/
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <MemIoSim.h>
+#include <RegistersClass.h>
+#include <RegistersAsync.h>
+#include <TestCheck.h>
+
+using namespace Register;
+
+struct Status : public Description< 0x4000, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RO< getAddress(), Bit< 0 > > Lock;
+	typedef RO< getAddress(), Bit< 1 > > Ready;
+	typedef RS< getAddress(), Field< 31, 2 > > Reserved;
+	typedef FieldSet< Lock, Ready > ReadOnlyFields;
+};
+
+struct Fifo : public Description< 0x4004, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RO< getAddress(), Field< 7, 0 > > Level;
+	typedef RS< getAddress(), Field< 31, 8 > > Reserved;
+	typedef FieldSet< Level > ReadOnlyFields;
+};
+
+/* Result of task, it is filled, when task is done */
+struct Outcome {
+	bool done { false };
+	Wait::Status status { Wait::Status::Done };
+};
+
+static Async::Task waitLock( Outcome& outcome ) {
+	outcome.status = co_await Until< Status, Status::Lock >( 1 ).For( std::chrono::seconds( 10 ) );
+	outcome.done = true;
+}
+
+static Async::Task waitReady( Outcome& outcome, const std::chrono::milliseconds timeout ) {
+	outcome.status = co_await Until< Status, Status::Ready >( 1 ).For( timeout );
+	outcome.done = true;
+}
+
+/*
+	Two waits one after another, the second one is added by resumed task.
+	Status is kept in local: GCC 12 crashes on resume, when co_await is in condition of if with co_return.
+*/
+static Async::Task waitLockThenLevel( Outcome& outcome ) {
+	const Wait::Status locked = co_await Until< Status, Status::Lock >( 1 );
+	if ( Wait::Status::Done != locked ) {
+		co_return;
+	}
+	outcome.status = co_await Until< Fifo, Fifo::Level >( 4 );
+	outcome.done = true;
+}
+
+static void testExecutor() {
+	Test::group( "Executor" );
+	Sim::File& file = Sim::File::instance();
+	Async::Executor& executor = Async::Executor::instance();
+	file.clear();
+	/* Lock is asserted by the 5th read */
+	Sim::AssertAfterReads lock( 0x1, 4 );
+	file.add( Status::getAddress(), 0, Sim::Mode::ReadOnly ).attach( Status::getAddress(), lock );
+
+	Outcome locked;
+	Outcome ready;
+	waitLock( locked );
+	waitReady( ready, std::chrono::milliseconds( 50 ) );
+	/* Condition is checked before suspend */
+	CHECK( file.cell( Status::getAddress() )->reads == 2 );
+	CHECK( executor.Pending() == 2 );
+	CHECK( !locked.done && !ready.done );
+
+	/* Waiters of the same register share one read of each pass */
+	CHECK( executor.Poll() == 0 );
+	CHECK( file.cell( Status::getAddress() )->reads == 3 );
+	CHECK( executor.Poll() == 0 );
+	CHECK( executor.Poll() == 1 );
+	CHECK( file.cell( Status::getAddress() )->reads == 5 );
+	CHECK( locked.done );
+	CHECK( locked.status == Wait::Status::Done );
+	CHECK( executor.Pending() == 1 );
+
+	/* Ready is never asserted: waiter is resumed by timeout */
+	const auto start = Async::Clock::now();
+	executor.Run();
+	CHECK( ready.done );
+	CHECK( ready.status == Wait::Status::Timeout );
+	CHECK( ( Async::Clock::now() - start ) < std::chrono::seconds( 10 ) );
+	CHECK( executor.Empty() );
+	CHECK( executor.Pending() == 0 );
+}
+
+static void testChain() {
+	Test::group( "Chain" );
+	Sim::File& file = Sim::File::instance();
+	Async::Executor& executor = Async::Executor::instance();
+	file.clear();
+	file.add( Status::getAddress(), 0 ).add( Fifo::getAddress(), 0 );
+
+	/* Condition, which holds at once, doesn't suspend */
+	Outcome immediate;
+	file.poke( Status::getAddress(), 1 );
+	waitLock( immediate );
+	CHECK( immediate.done );
+	CHECK( executor.Empty() );
+
+	Outcome chain;
+	file.poke( Status::getAddress(), 0 );
+	waitLockThenLevel( chain );
+	CHECK( executor.Pending() == 1 );
+	file.poke( Status::getAddress(), 1 );
+	CHECK( executor.Poll() == 1 );
+	CHECK( !chain.done );
+	CHECK( executor.Pending() == 1 );
+	CHECK( executor.Poll() == 0 );
+	file.poke( Fifo::getAddress(), 4 );
+	executor.Run();
+	CHECK( chain.done );
+	CHECK( chain.status == Wait::Status::Done );
+	CHECK( executor.Empty() );
+}
+
+static void testOwnExecutor() {
+	Test::group( "Own executor" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Status::getAddress(), 0 );
+
+	Async::Executor executor;
+	Outcome outcome;
+	[]( Async::Executor& executor, Outcome& outcome ) -> Async::Task {
+		outcome.status = co_await Until< Status, Status::Ready >( 1 ).On( executor );
+		outcome.done = true;
+	}( executor, outcome );
+	CHECK( executor.Pending() == 1 );
+	CHECK( Async::Executor::instance().Empty() );
+	file.poke( Status::getAddress(), 2 );
+	executor.Run();
+	CHECK( outcome.done );
+	CHECK( executor.Empty() );
+}
+
+int main() {
+	testExecutor();
+	testChain();
+	testOwnExecutor();
+	return Test::result();
+}
@@ -0,0 +1,140 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Behavioral test of Linux backend: memfd window stands in for /dev/mem, eventfd for UIO device */
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <MemIoLinux.h>
+#include <RegistersClass.h>
+#include <RegistersWait.h>
+#include <TestCheck.h>
+
+using namespace Register;
+
+/* Window isn't page aligned: it is placed at file offset 0x1100 */
+struct CrgWindow : public Linux::Window< 0x12010100, 0x100 > {};
+static constexpr const off_t WindowOffset = 0x1100;
+
+typedef Linux::MappedIo< CrgWindow > CrgIo;
+
+struct Ctrl : public Description< 0x12010100, uint32_t, CrgIo > {
+	typedef RW< getAddress(), Field< 3, 0 > > Mode;
+	typedef RW< getAddress(), Field< 15, 8 > > Div;
+	typedef RS< getAddress(), Field< 7, 4 >, Field< 31, 16 > > Reserved;
+};
+
+struct Status : public Description< 0x12010104, uint32_t, CrgIo > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RO< getAddress(), Bit< 0 > > Lock;
+	typedef RS< getAddress(), Field< 31, 1 > > Reserved;
+	typedef FieldSet< Lock > ReadOnlyFields;
+};
+
+/* Register value in file, as device sees it */
+static uint32_t peek( const int fd, const AddressType address ) {
+	uint32_t value = 0;
+	(void)!::pread( fd, &value, sizeof( value ), WindowOffset + static_cast<off_t>( address - CrgWindow::getPhysBase() ) );
+	return value;
+}
+
+static void poke( const int fd, const AddressType address, const uint32_t value ) {
+	(void)!::pwrite( fd, &value, sizeof( value ), WindowOffset + static_cast<off_t>( address - CrgWindow::getPhysBase() ) );
+}
+
+static void testMappedIo( const int fd ) {
+	Test::group( "MappedIo" );
+	poke( fd, Ctrl::getAddress(), 0x0201 );
+	CHECK( Ctrl::Div::get() == 2 );
+	Ctrl::Mode::set( 5 );
+	CHECK( peek( fd, Ctrl::getAddress() ) == 0x0205 );
+	Write< Ctrl, Ctrl::Mode, Ctrl::Div >( 1, 0x22 );
+	CHECK( peek( fd, Ctrl::getAddress() ) == 0x2201 );
+	CHECK( ( IsEqual< Ctrl, Ctrl::Mode, Ctrl::Div >( 1, 0x22 ) ) );
+	/* Register is placed at the same page offset, as it is in file */
+	const AddressType pageSize = static_cast<AddressType>( ::sysconf( _SC_PAGESIZE ) );
+	CHECK( ( CrgWindow::getBase() % pageSize ) == ( static_cast<AddressType>( WindowOffset ) % pageSize ) );
+}
+
+static void testMappedBlock( const int fd ) {
+	Test::group( "MappedBlock" );
+	const Linux::MappedBlock< CrgWindow > crg;
+	CHECK( crg.getBase() == CrgWindow::getBase() );
+	crg.Write< Ctrl, Ctrl::Mode, Ctrl::Div >( 3, 0x44 );
+	CHECK( peek( fd, Ctrl::getAddress() ) == 0x4403 );
+	crg.Set< Ctrl::Mode >( 7 );
+	CHECK( peek( fd, Ctrl::getAddress() ) == 0x4407 );
+	CHECK( ( crg.Get< Ctrl, Ctrl::Div >() == 0x44 ) );
+	poke( fd, Status::getAddress(), 1 );
+	CHECK( ( crg.IsEqual< Status, Status::Lock >( 1 ) ) );
+	poke( fd, Status::getAddress(), 0 );
+}
+
+static void testIrqWait( const int fd ) {
+	Test::group( "Irq wait" );
+	const int event = ::eventfd( 0, EFD_CLOEXEC );
+	CHECK( event >= 0 );
+	if ( event < 0 ) {
+		return;
+	}
+
+	{
+		/* Device sets lock bit and raises interrupt: waiter is woken, not timed out */
+		std::thread device( [ fd, event ]() {
+			std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+			poke( fd, Status::getAddress(), 1 );
+			const uint64_t one = 1;
+			(void)!::write( event, &one, sizeof( one ) );
+		} );
+		const auto result = WaitFor< Status, Status::Lock >( 1, Wait::Irq<>{ std::chrono::seconds( 10 ), event, Wait::IrqSource::EventFd } );
+		device.join();
+		CHECK( result );
+		CHECK( result.polls <= 3 );
+		CHECK( result.elapsed < std::chrono::seconds( 10 ) );
+	}
+	{
+		/* No interrupt: thread is blocked until timeout, register isn't polled */
+		poke( fd, Status::getAddress(), 0 );
+		const auto result = WaitFor< Status, Status::Lock >( 1, Wait::Irq<>{ std::chrono::milliseconds( 20 ), event, Wait::IrqSource::EventFd } );
+		CHECK( !result );
+		CHECK( result.elapsed >= std::chrono::milliseconds( 20 ) );
+		CHECK( result.polls <= 3 );
+	}
+	{
+		/* Without interrupt register is polled every poll interval */
+		std::thread device( [ fd ]() {
+			std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+			poke( fd, Status::getAddress(), 1 );
+		} );
+		const auto result = WaitFor< Status, Status::Lock >( 1, Wait::Irq<>{ std::chrono::seconds( 10 ), -1, Wait::IrqSource::EventFd, std::chrono::milliseconds( 1 ) } );
+		device.join();
+		CHECK( result );
+		CHECK( result.polls >= 2 );
+	}
+	::close( event );
+}
+
+int main() {
+	const int fd = ::memfd_create( "regs", MFD_CLOEXEC );
+	CHECK( fd >= 0 );
+	CHECK( ( fd >= 0 ) && ( 0 == ::ftruncate( fd, 0x2000 ) ) );
+	if ( 0 != Test::failures() ) {
+		return Test::result();
+	}
+	{
+		Linux::Mapping< CrgWindow > mapping( fd, WindowOffset );
+		CHECK( mapping.isMapped() );
+		CHECK( CrgWindow::isMapped() );
+		if ( mapping.isMapped() ) {
+			testMappedIo( fd );
+			testMappedBlock( fd );
+			testIrqWait( fd );
+		}
+	}
+	CHECK( !CrgWindow::isMapped() );
+	::close( fd );
+	return Test::result();
+}
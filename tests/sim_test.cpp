@@ -0,0 +1,525 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Behavioral test of register access, simulated register file backend */
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <MemIoSim.h>
+#include <RegistersClass.h>
+#include <RegistersWait.h>
+#include <RegistersSequence.h>
+#include <TestCheck.h>
+
+using namespace Register;
+
+/* Control register: RW fields and reserved bits */
+struct Ctrl : public Description< 0x1000, uint32_t, Sim::Io > {
+	typedef RW< getAddress(), Field< 3, 0 > > Mode;
+	typedef RW< getAddress(), Field< 15, 8 > > Div;
+	typedef RS< getAddress(), Field< 7, 4 >, Field< 31, 16 > > Reserved;
+};
+
+/* Interrupt status: W1C fields and RW enable bit */
+struct IrqStatus : public Description< 0x1004, uint32_t, Sim::Io > {
+	typedef W1C< getAddress(), Bit< 0 >, IrqStatus > Done;
+	typedef W1C< getAddress(), Bit< 1 >, IrqStatus > Error;
+	typedef RW< getAddress(), Bit< 8 > > Enable;
+	typedef RS< getAddress(), Field< 7, 2 >, Field< 31, 9 > > Reserved;
+	typedef FieldSet< Done, Error > WriteOneFields;
+};
+
+/* Interrupt acknowledge: W1C fields only */
+struct IrqAck : public Description< 0x1008, uint32_t, Sim::Io > {
+	typedef W1C< getAddress(), Bit< 0 >, IrqAck > Done;
+	typedef W1C< getAddress(), Bit< 1 >, IrqAck > Error;
+	typedef RS< getAddress(), Field< 31, 2 > > Reserved;
+	typedef FieldSet< Done, Error > WriteOneFields;
+};
+
+/* Register with SET (+4) and CLR (+8) alias registers */
+struct Gpio : public Description< 0x2000, uint32_t, Sim::Io > {
+	typedef SC< getAddress(), Field< 3, 0 >, 4, 8 > Out;
+	typedef RW< getAddress(), Field< 7, 4 > > Drive;
+	typedef SC< getAddress(), Bit< 8 >, 4, 8 > Enable;
+	typedef RS< getAddress(), Field< 31, 9 > > Reserved;
+};
+
+typedef Array< Gpio, 0x10, 2 > GpioArray;
+
+/* Register with read to clear field, RMW is forbidden */
+struct Event : public Description< 0x3000, uint32_t, Sim::Io, Mem32IoReadClearDescription > {
+	typedef RC< getAddress(), Field< 3, 0 > > Pending;
+	typedef RW< getAddress(), Field< 7, 4 > > Mask;
+	typedef RS< getAddress(), Field< 31, 8 > > Reserved;
+	typedef FieldSet< Pending > ReadOnlyFields;
+};
+
+/* Status register, it is changed by hardware */
+struct Status : public Description< 0x4000, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RO< getAddress(), Bit< 0 > > Lock;
+	typedef RO< getAddress(), Bit< 1 > > Ready;
+	typedef RS< getAddress(), Field< 31, 2 > > Reserved;
+	typedef FieldSet< Lock, Ready > ReadOnlyFields;
+};
+
+struct Pll : public Description< 0x5000, uint32_t, Sim::Io > {
+	typedef RW< getAddress(), Field< 11, 0 > > Frac;
+	typedef RW< getAddress(), Field< 14, 12 > > Postdiv;
+	typedef RW< getAddress(), Bit< 15 > > Bypass;
+	typedef RS< getAddress(), Field< 31, 16 > > Reserved;
+};
+
+struct PllLock : public Description< 0x5004, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RO< getAddress(), Bit< 0 > > Lock;
+	typedef RS< getAddress(), Field< 31, 1 > > Reserved;
+	typedef FieldSet< Lock > ReadOnlyFields;
+};
+
+/* 64 bit counter as HI and LO registers */
+struct CounterHi : public Description< 0x6000, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RS< getAddress() > Reserved;
+};
+
+struct CounterLo : public Description< 0x6004, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RS< getAddress() > Reserved;
+};
+
+/* Sequence counter of hardware, odd while data is updated */
+struct Version : public Description< 0x6008, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	static constexpr const bool SequenceCounter = true;
+	typedef RS< getAddress() > Reserved;
+};
+
+struct Data : public Description< 0x600C, uint32_t, Sim::Io > {
+	static constexpr const bool HardwareUpdated = true;
+	typedef RS< getAddress() > Reserved;
+};
+
+/* Register is incremented by the first "ticks" reads */
+class Ticking : public Sim::Behavior {
+public:
+	explicit Ticking( const uint32_t ticks ) : _ticks( ticks ), _left( ticks ) {};
+
+	void onRead( uint64_t& value ) override {
+		if ( _left > 0 ) {
+			_left--;
+			value++;
+		}
+	}
+
+	void onReset() override { _left = _ticks; }
+
+private:
+	const uint32_t _ticks;
+	uint32_t _left;
+};
+
+/* Bus accesses of register file since construction */
+class Accesses {
+public:
+	Accesses() : _reads( Sim::File::instance().counters().reads ), _writes( Sim::File::instance().counters().writes ) {};
+	uint64_t reads() const { return Sim::File::instance().counters().reads - _reads; }
+	uint64_t writes() const { return Sim::File::instance().counters().writes - _writes; }
+
+private:
+	const uint64_t _reads;
+	const uint64_t _writes;
+};
+
+static constexpr const Sequence::StepOf< Pll > pllSequence[] = {
+	Sequence::Write< Pll, Pll::Bypass >( 1 ),
+	Sequence::Write< Pll, Pll::Frac, Pll::Postdiv, Pll::Bypass >( 0x123, 2, 0 ),
+	Sequence::Delay( 10 ),
+	Sequence::WaitFor< PllLock, PllLock::Lock >( 10000, 1 ),
+};
+
+static constexpr const Sequence::StepOf< Pll > timeoutSequence[] = {
+	Sequence::Write< Pll, Pll::Bypass >( 1 ),
+	Sequence::WaitFor< PllLock, PllLock::Lock >( 2, 1 ),
+	Sequence::Write< Pll, Pll::Bypass >( 0 ),
+};
+
+static constexpr const Sequence::StepOf< Pll > delaySequence[] = {
+	Sequence::Delay( 2000 ),
+};
+
+static void testWrite() {
+	Test::group( "Write and RMW" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Ctrl::getAddress(), 0xFFFF0203 );
+
+	{
+		/* Partial write is RMW, reserved bits are written as 0 */
+		const Accesses accesses;
+		Write< Ctrl, Ctrl::Mode >( 5 );
+		CHECK( accesses.reads() == 1 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x0205 );
+	}
+	{
+		/* All fields are written by single store */
+		const Accesses accesses;
+		Write< Ctrl, Ctrl::Mode, Ctrl::Div >( 1, 0x22 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x2201 );
+	}
+	{
+		const Accesses accesses;
+		Ctrl::Div::set( 0x33 );
+		CHECK( accesses.reads() == 1 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x3301 );
+		CHECK( Ctrl::Div::get() == 0x33 );
+		CHECK( ( IsEqual< Ctrl, Ctrl::Mode, Ctrl::Div >( 1, 0x33 ) ) );
+		CHECK( ( !IsEqual< Ctrl, Ctrl::Mode >( 2 ) ) );
+	}
+	{
+		/* Transaction writes are the same stores */
+		const Accesses accesses;
+		{
+			Transaction transaction;
+			transaction.Write< Ctrl, Ctrl::Mode, Ctrl::Div >( 7, 0x44 );
+			transaction.Write< Ctrl, Ctrl::Mode >( 8 );
+		}
+		CHECK( accesses.reads() == 1 );
+		CHECK( accesses.writes() == 2 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x4408 );
+	}
+	CHECK( file.counters().violations == 0 );
+}
+
+static void testWriteOne() {
+	Test::group( "W1C" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( IrqStatus::getAddress() ).add( IrqAck::getAddress() );
+
+	{
+		/* RW bits are kept by RMW, the other W1C bit is written as 0 */
+		file.poke( IrqStatus::getAddress(), 0x103 );
+		const Accesses accesses;
+		IrqStatus::Done::set( 1 );
+		CHECK( accesses.reads() == 1 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( IrqStatus::getAddress() ) == 0x101 );
+	}
+	{
+		/* Register without RW bits, single store */
+		file.poke( IrqAck::getAddress(), 0x3 );
+		const Accesses accesses;
+		IrqAck::Error::set( 1 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( IrqAck::getAddress() ) == 0x2 );
+	}
+	{
+		file.poke( IrqStatus::getAddress(), 0x103 );
+		const Accesses accesses;
+		Write< IrqStatus, IrqStatus::Error, IrqStatus::Enable >( 1, 0 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( file.peek( IrqStatus::getAddress() ) == 0x2 );
+	}
+	CHECK( file.counters().violations == 0 );
+}
+
+static void testSetClear() {
+	Test::group( "SET/CLR" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	for ( size_t index = 0; index < GpioArray::getCount(); index++ ) {
+		const AddressType address = Gpio::getAddress() + ( index * GpioArray::getStride() );
+		file.add( address, 0xF0 ).add( address + 4 ).add( address + 8 );
+	}
+
+	{
+		/* 1 bits are stored to SET alias, 0 bits to CLR alias, register isn't read or written */
+		const Accesses accesses;
+		Write< Gpio, Gpio::Out >( 5 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 2 );
+		CHECK( file.peek( Gpio::getAddress() + 4 ) == 0x5 );
+		CHECK( file.peek( Gpio::getAddress() + 8 ) == 0xA );
+		CHECK( file.peek( Gpio::getAddress() ) == 0xF0 );
+	}
+	{
+		/* Single bit is one store */
+		file.reset();
+		const Accesses accesses;
+		Gpio::Enable::set( 1 );
+		Gpio::Enable::set( 0 );
+		CHECK( accesses.writes() == 2 );
+		CHECK( file.peek( Gpio::getAddress() + 4 ) == 0x100 );
+		CHECK( file.peek( Gpio::getAddress() + 8 ) == 0x100 );
+	}
+	{
+		file.reset();
+		const Accesses accesses;
+		{
+			Transaction transaction;
+			transaction.Write< Gpio, Gpio::Out >( 3 );
+		}
+		CHECK( accesses.reads() == 0 );
+		CHECK( file.peek( Gpio::getAddress() + 4 ) == 0x3 );
+		CHECK( file.peek( Gpio::getAddress() + 8 ) == 0xC );
+	}
+	{
+		file.reset();
+		const Accesses accesses;
+		GpioArray::WriteAll< Gpio::Out >( 6 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 4 );
+		CHECK( file.peek( Gpio::getAddress() + 0x14 ) == 0x6 );
+		CHECK( file.peek( Gpio::getAddress() + 0x18 ) == 0x9 );
+		CHECK( GpioArray::Write< Gpio::Out >( 0x2, 0x1 ) );
+		CHECK( file.peek( Gpio::getAddress() + 0x14 ) == 0x1 );
+		CHECK( file.peek( Gpio::getAddress() + 0x04 ) == 0x6 );
+		CHECK( !GpioArray::Write< Gpio::Out >( 0x4, 0x1 ) );
+	}
+	CHECK( file.counters().violations == 0 );
+}
+
+static void testReadToClear() {
+	Test::group( "RC" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Event::getAddress(), 0x5 );
+
+	/* Register with RC field isn't read by write, RC bits are written as 0 */
+	const Accesses accesses;
+	Write< Event, Event::Mask >( 3 );
+	CHECK( accesses.reads() == 0 );
+	CHECK( accesses.writes() == 1 );
+	CHECK( file.peek( Event::getAddress() ) == 0x30 );
+	CHECK( Event::Pending::get() == 0 );
+}
+
+static void testWaitFor() {
+	Test::group( "WaitFor" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	Sim::AssertAfterReads lock( 0x1, 3 );
+	file.add( Status::getAddress(), 0, Sim::Mode::ReadOnly ).attach( Status::getAddress(), lock );
+
+	{
+		const auto result = WaitFor< Status, Status::Lock >( 1, Wait::Spin<>{ std::chrono::seconds( 1 ) } );
+		CHECK( result );
+		CHECK( result.status == Wait::Status::Done );
+		CHECK( result.polls == 4 );
+	}
+	{
+		const auto result = WaitFor< Status, Status::Lock, Status::Ready >( 1, 1, Wait::Backoff<>{ std::chrono::milliseconds( 2 ) } );
+		CHECK( !result );
+		CHECK( result.status == Wait::Status::Timeout );
+		CHECK( result.elapsed >= std::chrono::milliseconds( 2 ) );
+	}
+	{
+		Sim::AssertAfterTime ready( 0x2, std::chrono::milliseconds( 2 ) );
+		file.attach( Status::getAddress(), ready );
+		const auto result = WaitFor< Status, Status::Ready >( 1, Wait::Relax<>{ std::chrono::seconds( 1 ) } );
+		CHECK( result );
+		CHECK( result.polls > 1 );
+		file.clear();
+	}
+}
+
+static void testSequence() {
+	Test::group( "Sequence" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	/* PLL is locked after 3 reads, PLL write restarts lock */
+	Sim::AssertAfterReads lock( 0x1, 3, Pll::getAddress() );
+	file.add( Pll::getAddress() ).add( PllLock::getAddress(), 0, Sim::Mode::ReadOnly ).attach( PllLock::getAddress(), lock );
+
+	CHECK( sizeof( pllSequence[0] ) == 16 );
+	CHECK( Sequence::Run( pllSequence ) == 4 );
+	CHECK( file.peek( Pll::getAddress() ) == 0x2123 );
+	CHECK( file.cell( PllLock::getAddress() )->reads == 4 );
+	CHECK( file.cell( Pll::getAddress() )->writes == 2 );
+
+	file.reset();
+	CHECK( Sequence::RunUnrolled< pllSequence >() == 4 );
+	CHECK( file.peek( Pll::getAddress() ) == 0x2123 );
+	CHECK( file.cell( PllLock::getAddress() )->reads == 4 );
+
+	/* Timeout is 2 reads, PLL isn't locked yet: the last step isn't executed */
+	file.reset();
+	CHECK( Sequence::Run( timeoutSequence ) == 1 );
+	CHECK( file.peek( Pll::getAddress() ) == 0x8000 );
+	CHECK( file.cell( PllLock::getAddress() )->reads == 2 );
+	file.reset();
+	CHECK( Sequence::RunUnrolled< timeoutSequence >() == 1 );
+	CHECK( file.peek( Pll::getAddress() ) == 0x8000 );
+
+	/* Clocked time base: timeout and delay are microseconds */
+	file.reset();
+	CHECK( Sequence::Run< Sequence::Clocked<> >( pllSequence ) == 4 );
+	CHECK( file.peek( Pll::getAddress() ) == 0x2123 );
+	const auto start = std::chrono::steady_clock::now();
+	CHECK( Sequence::Run< Sequence::Clocked<> >( delaySequence ) == 1 );
+	CHECK( ( std::chrono::steady_clock::now() - start ) >= std::chrono::microseconds( 2000 ) );
+	CHECK( file.counters().violations == 0 );
+}
+
+static void testContext() {
+	Test::group( "Context" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Ctrl::getAddress(), 0x0201 ).add( Pll::getAddress(), 0x2123 );
+
+	typedef Context< Ctrl, Pll > Saved;
+	CHECK( Saved::getSize() == 8 );
+	Saved saved;
+	saved.Save();
+	CHECK( saved.Value< Ctrl >() == 0x0201 );
+	CHECK( ( saved.Get< Pll, Pll::Frac >() == 0x123 ) );
+
+	{
+		/* Only changed register is written */
+		file.poke( Ctrl::getAddress(), 0x0F0F );
+		const Accesses accesses;
+		CHECK( saved.RestoreDiff() == 1 );
+		CHECK( accesses.reads() == 2 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x0201 );
+		CHECK( saved.RestoreDiff() == 0 );
+	}
+	{
+		/* Live values are taken from shadow context, there are no reads */
+		file.poke( Pll::getAddress(), 0x8000 );
+		Saved live;
+		live.Save();
+		const Accesses accesses;
+		CHECK( saved.RestoreDiff( live ) == 1 );
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Pll::getAddress() ) == 0x2123 );
+		CHECK( live.Value< Pll >() == 0x2123 );
+		CHECK( saved.RestoreDiff( live ) == 0 );
+	}
+	{
+		file.poke( Ctrl::getAddress(), 0 );
+		file.poke( Pll::getAddress(), 0 );
+		const Accesses accesses;
+		saved.Restore();
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 2 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x0201 );
+		CHECK( file.peek( Pll::getAddress() ) == 0x2123 );
+	}
+}
+
+static void testShadowed() {
+	Test::group( "Shadowed" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Ctrl::getAddress(), 0x0201 );
+
+	typedef Shadowed< Ctrl > Shadow;
+	{
+		/* The first partial write reads register once */
+		const Accesses accesses;
+		Shadow::Write< Ctrl::Mode >( 3 );
+		Shadow::Set< Ctrl::Div >( 4 );
+		CHECK( accesses.reads() == 1 );
+		CHECK( accesses.writes() == 2 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x0403 );
+		CHECK( Shadow::Get< Ctrl::Mode >() == 3 );
+		CHECK( accesses.reads() == 1 );
+	}
+	{
+		/* After invalidate shadow copy is read again */
+		file.poke( Ctrl::getAddress(), 0x0506 );
+		Shadow::Invalidate();
+		const Accesses accesses;
+		CHECK( Shadow::Get< Ctrl::Div >() == 5 );
+		CHECK( accesses.reads() == 1 );
+		Shadow::Write< Ctrl::Mode, Ctrl::Div >( 1, 2 );
+		CHECK( accesses.reads() == 1 );
+		CHECK( Shadow::Value() == 0x0201 );
+		CHECK( file.peek( Ctrl::getAddress() ) == 0x0201 );
+	}
+}
+
+static void testStaged() {
+	Test::group( "Staged" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Pll::getAddress(), 0x8000 );
+
+	{
+		/* Fields cover whole register at run time, flush is a single store */
+		auto staged = Staged< Pll >().With< Pll::Frac >( 0x55 ).With< Pll::Postdiv >( 3 );
+		staged.Set< Pll::Bypass >( 0 );
+		CHECK( file.peek( Pll::getAddress() ) == 0x8000 );
+		const Accesses accesses;
+		staged.Flush();
+		CHECK( accesses.reads() == 0 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Pll::getAddress() ) == 0x3055 );
+	}
+	{
+		/* Omitted fields are kept, flush is RMW */
+		auto staged = Staged< Pll >().With< Pll::Frac >( 0x1 );
+		const Accesses accesses;
+		staged.Flush();
+		CHECK( accesses.reads() == 1 );
+		CHECK( accesses.writes() == 1 );
+		CHECK( file.peek( Pll::getAddress() ) == 0x3001 );
+	}
+}
+
+static void testConsistentRead() {
+	Test::group( "ConsistentRead" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	/* Upper word is changed by the first two reads: the first attempt is torn */
+	Ticking ticking( 2 );
+	file.add( CounterHi::getAddress(), 0 ).attach( CounterHi::getAddress(), ticking ).add( CounterLo::getAddress(), 0x1234 );
+	file.add( Version::getAddress(), 1 ).add( Data::getAddress(), 0x55 );
+
+	{
+		const auto counter = ConsistentRead< CounterHi, CounterLo >();
+		CHECK( counter );
+		CHECK( counter.getAttempts() == 2 );
+		CHECK( counter.Value< CounterHi >() == 2 );
+		CHECK( counter.Value< CounterLo >() == 0x1234 );
+	}
+	{
+		/* Retries are exhausted, the last attempt is kept */
+		file.reset();
+		const auto counter = ConsistentRead< CounterHi, CounterLo >( 0 );
+		CHECK( !counter.IsConsistent() );
+		CHECK( counter.getAttempts() == 1 );
+	}
+	{
+		/* Odd sequence counter: update is in progress, even if counter isn't changed */
+		const auto data = ConsistentRead< Version, Data >( 2 );
+		CHECK( !data );
+		CHECK( data.getAttempts() == 3 );
+		file.poke( Version::getAddress(), 2 );
+		const auto updated = ConsistentRead< Version, Data >( 2 );
+		CHECK( updated );
+		CHECK( updated.getAttempts() == 1 );
+		CHECK( updated.Value< Data >() == 0x55 );
+	}
+}
+
+int main() {
+	testWrite();
+	testWriteOne();
+	testSetClear();
+	testReadToClear();
+	testWaitFor();
+	testSequence();
+	testContext();
+	testShadowed();
+	testStaged();
+	testConsistentRead();
+	return Test::result();
+}
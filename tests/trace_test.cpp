@@ -0,0 +1,86 @@
+/* (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia, 	*/
+/* Behavioral test of access trace ring, it is built with REGISTER_TRACE */
+
+#include <cstddef>
+#include <cstdint>
+#include <MemIoSim.h>
+#include <RegistersClass.h>
+#include <RegistersTrace.h>
+#include <TestCheck.h>
+
+#if !defined(REGISTER_TRACE)
+#error "Trace test is built with REGISTER_TRACE"
+#endif
+
+using namespace Register;
+
+struct Ctrl : public Description< 0x1000, uint32_t, Sim::Io > {
+	typedef RW< getAddress(), Field< 3, 0 > > Mode;
+	typedef RW< getAddress(), Field< 15, 8 > > Div;
+	typedef RS< getAddress(), Field< 7, 4 >, Field< 31, 16 > > Reserved;
+};
+
+static void testRecords() {
+	Test::group( "Records" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Ctrl::getAddress() );
+	Trace::ring().clear();
+
+	/* Single store, then RMW: read and write of field mask */
+	Write< Ctrl, Ctrl::Mode, Ctrl::Div >( 1, 0x22 );
+	Ctrl::Mode::set( 3 );
+	CHECK( Ctrl::Div::get() == 0x22 );
+
+	Trace::Record records[ REGISTER_TRACE_SIZE ];
+	CHECK( Trace::ring().pushed() == 4 );
+	CHECK( Trace::ring().read( records, REGISTER_TRACE_SIZE ) == 4 );
+	CHECK( records[0].op == Trace::Op::Write );
+	CHECK( records[0].address == Ctrl::getAddress() );
+	CHECK( records[0].mask == 0xFFFFFFFF );
+	CHECK( records[0].value == 0x2201 );
+	CHECK( records[1].op == Trace::Op::Read );
+	CHECK( records[1].mask == 0xF );
+	CHECK( records[1].value == 0x2201 );
+	CHECK( records[2].op == Trace::Op::Write );
+	CHECK( records[2].mask == 0xF );
+	CHECK( records[2].value == 0x2203 );
+	CHECK( records[3].op == Trace::Op::Read );
+	CHECK( records[3].mask == 0xFF00 );
+	CHECK( records[1].timestamp <= records[3].timestamp );
+
+	/* The latest records, from the oldest one */
+	CHECK( Trace::ring().read( records, 2 ) == 2 );
+	CHECK( records[0].op == Trace::Op::Write );
+	CHECK( records[0].value == 0x2203 );
+	CHECK( records[1].op == Trace::Op::Read );
+}
+
+static void testWrap() {
+	Test::group( "Wrap" );
+	Sim::File& file = Sim::File::instance();
+	file.clear();
+	file.add( Ctrl::getAddress() );
+	Trace::ring().clear();
+
+	/* The oldest records are overwritten */
+	const uint32_t writes = REGISTER_TRACE_SIZE + 3;
+	for ( uint32_t index = 0; index < writes; index++ ) {
+		Write< Ctrl, Ctrl::Mode, Ctrl::Div >( index & 0xF, 0 );
+	}
+	Trace::Record records[ REGISTER_TRACE_SIZE ];
+	CHECK( Trace::ring().pushed() == writes );
+	CHECK( Trace::ring().dropped() == 0 );
+	CHECK( Trace::ring().read( records, REGISTER_TRACE_SIZE ) == REGISTER_TRACE_SIZE );
+	CHECK( records[0].value == ( 3 & 0xF ) );
+	CHECK( records[ REGISTER_TRACE_SIZE - 1 ].value == ( ( writes - 1 ) & 0xF ) );
+
+	Trace::ring().clear();
+	CHECK( Trace::ring().read( records, REGISTER_TRACE_SIZE ) == 0 );
+}
+
+int main() {
+	testRecords();
+	testWrap();
+	return Test::result();
+}
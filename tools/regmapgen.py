@@ -0,0 +1,679 @@
+#!/usr/bin/env python3
+
+# (C) Evgeny Sobolev 09.02.1984 y.b., VRN, Russia
+# Register map generator
+
+"""
+Register map generator: CMSIS-SVD, IP-XACT or CSV device description is converted
+into headers of RegistersClass.h format, one header per peripheral.
+
+Generated register descriptions carry precomputed values, so compiler doesn't derive them:
+    - reserved bits as single mask:         typedef RS< getAddress(), BitMask< 0x88000000 > > Reserved;
+    - reset value of register:              static constexpr const uint32_t ResetValue = 0x...;
+      (or FieldDefaults, when reset value is known only for some fields)
+    - access mode of each field:            RW, RO, WO, W1C, W1S, RC (W1C/W1S are bound to register type)
+    - write-one fields of register:         typedef FieldSet< ... > WriteOneFields;
+    - read-only fields (skipped by Context): typedef FieldSet< ... > ReadOnlyFields;
+    - status registers (no writable field): static constexpr const bool HardwareUpdated = true;
+Overlapping fields, fields outside of register and enum values, which don't fit the field,
+are reported as errors (use --keep-going to drop such field and continue).
+
+Usage:
+    tools/regmapgen.py device.svd -o include/regs
+    tools/regmapgen.py block.xml --format ipxact -o include/regs --peripheral Uart0 --peripheral Gpio
+    tools/regmapgen.py map.csv -o include/regs --prefix hi3516ev200_
+
+    Each header is <prefix><peripheral>_regs.h, peripheral is namespace, its access backend
+    is macro <PERIPHERAL>_IO (Register::DirectIo by default), as in hi3516ev200_pll_regs.h.
+
+CSV format (header row is required, one row per field, register row may have empty field):
+    peripheral,base,register,offset,size,reset,field,msb,lsb,access,description
+    PeriCrg,0x12010000,PllConfig0,0x0,32,0x12000000,Frac,23,0,RW,Fractional part of multiplier
+    Access is RW, RO, WO, W1C, W1S, RC (or SVD access names).
+"""
+
+import argparse
+import csv
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+
+class Field:
+    def __init__(self, name, msb, lsb, access='RW', description=''):
+        self.name = name
+        self.msb = msb
+        self.lsb = lsb
+        self.access = access
+        self.description = description
+        # [ ( name, value, description ) ]
+        self.enums = []
+
+    def mask(self):
+        return ((1 << (self.msb - self.lsb + 1)) - 1) << self.lsb
+
+
+class Reg:
+    def __init__(self, name, address, size=32, reset=None, reset_mask=None, description=''):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.reset = reset
+        self.reset_mask = reset_mask
+        self.description = description
+        self.fields = []
+
+    def full_mask(self):
+        return (1 << self.size) - 1
+
+
+class Peripheral:
+    def __init__(self, name, base, description=''):
+        self.name = name
+        self.base = base
+        self.description = description
+        self.registers = []
+
+
+class GeneratorError(Exception):
+    pass
+
+
+# ------------------------------------------------------------------------------------------
+# Common helpers
+
+def parse_int(text, default=None):
+    if text is None:
+        return default
+    text = text.strip().lower().replace('_', '')
+    if text == '':
+        return default
+    if text.startswith('#'):
+        return int(text[1:], 2)
+    if text.startswith('0b'):
+        return int(text[2:], 2)
+    if text.startswith('0x'):
+        return int(text, 16)
+    # Verilog style 32'h1234
+    match = re.match(r"^\d*'([hdbo])([0-9a-f]+)$", text)
+    if match:
+        return int(match.group(2), {'h': 16, 'd': 10, 'b': 2, 'o': 8}[match.group(1)])
+    return int(text, 0) if text.startswith('0o') else int(text)
+
+
+def clean_text(text):
+    if text is None:
+        return ''
+    return ' '.join(text.split())
+
+
+ACCESS_NAMES = {
+    'read-write': 'RW', 'read-writeonce': 'RW', 'rw': 'RW',
+    'read-only': 'RO', 'ro': 'RO',
+    'write-only': 'WO', 'writeonce': 'WO', 'wo': 'WO',
+    'w1c': 'W1C', 'w1s': 'W1S', 'rc': 'RC',
+}
+
+
+def field_access(access, modified_write, read_action):
+    mode = ACCESS_NAMES.get((access or 'read-write').strip().lower(), 'RW')
+    modified_write = (modified_write or '').strip().lower()
+    if modified_write == 'onetoclear' and mode != 'RO':
+        return 'W1C'
+    if modified_write == 'onetoset' and mode != 'RO':
+        return 'W1S'
+    if (read_action or '').strip().lower() == 'clear' and mode in ('RO', 'RW'):
+        return 'RC'
+    return mode
+
+
+def expand_dim(name, dim, increment, index_text):
+    """ Register (or cluster) array: [ ( name, offset ) ] """
+    if dim is None:
+        return [(name, 0)]
+    if index_text:
+        range_match = re.match(r'^\s*(\d+)\s*-\s*(\d+)\s*$', index_text)
+        if range_match:
+            indexes = [str(i) for i in range(int(range_match.group(1)), int(range_match.group(2)) + 1)]
+        else:
+            indexes = [i.strip() for i in index_text.split(',')]
+    else:
+        indexes = [str(i) for i in range(dim)]
+    result = []
+    for number, index in enumerate(indexes[:dim]):
+        expanded = name.replace('[%s]', index).replace('%s', index)
+        result.append((expanded, number * (increment or 0)))
+    return result
+
+
+# ------------------------------------------------------------------------------------------
+# CMSIS-SVD
+
+def svd_text(node, tag, default=None):
+    child = node.find(tag)
+    return child.text if (child is not None and child.text is not None) else default
+
+
+def svd_props(node, inherited):
+    props = dict(inherited)
+    for tag in ('size', 'access', 'resetValue', 'resetMask'):
+        text = svd_text(node, tag)
+        if text is not None:
+            props[tag] = text
+    return props
+
+
+def svd_field_range(node):
+    bit_range = svd_text(node, 'bitRange')
+    if bit_range is not None:
+        match = re.match(r'^\s*\[\s*(\d+)\s*:\s*(\d+)\s*\]\s*$', bit_range)
+        return int(match.group(1)), int(match.group(2))
+    if svd_text(node, 'lsb') is not None:
+        return parse_int(svd_text(node, 'msb')), parse_int(svd_text(node, 'lsb'))
+    offset = parse_int(svd_text(node, 'bitOffset'), 0)
+    width = parse_int(svd_text(node, 'bitWidth'), 1)
+    return offset + width - 1, offset
+
+
+def svd_enums(node, enum_sets):
+    sets = node.findall('enumeratedValues')
+    if not sets:
+        return []
+    # Values of write usage are preferred, they are written by Register::Write
+    chosen = sets[0]
+    for values in sets:
+        if (svd_text(values, 'usage', 'read-write')).strip() != 'read':
+            chosen = values
+            break
+    derived = chosen.get('derivedFrom')
+    if derived is not None and derived.split('.')[-1] in enum_sets:
+        chosen = enum_sets[derived.split('.')[-1]]
+    result = []
+    for value in chosen.findall('enumeratedValue'):
+        text = svd_text(value, 'value')
+        if text is None or (text.strip().startswith('#') and 'x' in text.lower()):
+            # isDefault, or binary value with don't care bits
+            continue
+        result.append((svd_text(value, 'name'), parse_int(text), clean_text(svd_text(value, 'description'))))
+    return result
+
+
+def svd_fields(reg_node, enum_sets, reg_access):
+    fields = []
+    fields_node = reg_node.find('fields')
+    if fields_node is None:
+        return fields
+    for node in fields_node.findall('field'):
+        msb, lsb = svd_field_range(node)
+        dim = parse_int(svd_text(node, 'dim'))
+        for name, shift in expand_dim(svd_text(node, 'name'), dim, parse_int(svd_text(node, 'dimIncrement')), svd_text(node, 'dimIndex')):
+            field = Field(name, msb + shift, lsb + shift,
+                          field_access(svd_text(node, 'access', reg_access), svd_text(node, 'modifiedWriteValues'), svd_text(node, 'readAction')),
+                          clean_text(svd_text(node, 'description')))
+            field.enums = svd_enums(node, enum_sets)
+            fields.append(field)
+    return fields
+
+
+def svd_registers(parent, base, props, enum_sets, registers_by_name):
+    registers = []
+    for node in parent:
+        if node.tag not in ('register', 'cluster'):
+            continue
+        derived = node.get('derivedFrom')
+        source = registers_by_name.get(derived) if derived else None
+        node_props = svd_props(node, svd_props(source, props) if source is not None else props)
+        offset = parse_int(svd_text(node, 'addressOffset'), 0)
+        dim = parse_int(svd_text(node, 'dim'))
+        for name, shift in expand_dim(svd_text(node, 'name'), dim, parse_int(svd_text(node, 'dimIncrement')), svd_text(node, 'dimIndex')):
+            address = base + offset + shift
+            if node.tag == 'cluster':
+                for reg in svd_registers(node, address, node_props, enum_sets, registers_by_name):
+                    reg.name = name + '_' + reg.name
+                    registers.append(reg)
+                continue
+            reg = Reg(name, address, parse_int(node_props.get('size'), 32),
+                      parse_int(node_props.get('resetValue')), parse_int(node_props.get('resetMask')),
+                      clean_text(svd_text(node, 'description')))
+            fields_source = node if node.find('fields') is not None else source
+            reg.fields = svd_fields(fields_source, enum_sets, node_props.get('access')) if fields_source is not None else []
+            registers.append(reg)
+        registers_by_name[svd_text(node, 'name')] = node
+    return registers
+
+
+def load_svd(path):
+    root = ElementTree.parse(path).getroot()
+    bus_width = parse_int(svd_text(root, 'width'), 32)
+    device_props = svd_props(root, {'size': '32', 'access': 'read-write'})
+    # Named enumerated value sets, referenced by derivedFrom
+    enum_sets = {values.find('name').text: values for values in root.iter('enumeratedValues') if values.find('name') is not None}
+    nodes = {}
+    peripherals = []
+    for node in root.iter('peripheral'):
+        nodes[svd_text(node, 'name')] = node
+    for node in root.iter('peripheral'):
+        source = node
+        derived = node.get('derivedFrom')
+        if derived is not None:
+            if derived not in nodes:
+                raise GeneratorError('peripheral {}: unknown derivedFrom {}'.format(svd_text(node, 'name'), derived))
+            source = nodes[derived]
+        base = parse_int(svd_text(node, 'baseAddress'), 0)
+        props = svd_props(source, device_props)
+        props = svd_props(node, props)
+        peripheral = Peripheral(svd_text(node, 'name'), base, clean_text(svd_text(node, 'description') or svd_text(source, 'description')))
+        registers_node = source.find('registers')
+        if registers_node is not None:
+            peripheral.registers = svd_registers(registers_node, base, props, enum_sets, {})
+        peripherals.append(peripheral)
+    return peripherals, bus_width
+
+
+# ------------------------------------------------------------------------------------------
+# IP-XACT (SPIRIT 1.4/1685-2009, 1685-2014, 1685-2022), namespace is ignored
+
+def local(tag):
+    return tag.rsplit('}', 1)[-1]
+
+
+def ip_child(node, name):
+    for child in node:
+        if local(child.tag) == name:
+            return child
+    return None
+
+
+def ip_children(node, name):
+    return [child for child in node if local(child.tag) == name]
+
+
+def ip_text(node, path, default=None):
+    for name in path.split('/'):
+        node = ip_child(node, name) if node is not None else None
+    return node.text if (node is not None and node.text is not None) else default
+
+
+def ip_reset(node):
+    # 1685-2009: reset/value, reset/mask; 1685-2014: resets/reset/value
+    reset = ip_child(node, 'reset')
+    if reset is None:
+        resets = ip_child(node, 'resets')
+        reset = ip_child(resets, 'reset') if resets is not None else None
+    if reset is None:
+        return None, None
+    return parse_int(ip_text(reset, 'value')), parse_int(ip_text(reset, 'mask'))
+
+
+def load_ipxact(path):
+    root = ElementTree.parse(path).getroot()
+    peripherals = []
+    bus_width = 32
+    for memory_map in root.iter():
+        if local(memory_map.tag) != 'memoryMap':
+            continue
+        for block in ip_children(memory_map, 'addressBlock'):
+            bus_width = parse_int(ip_text(block, 'width'), bus_width)
+            base = parse_int(ip_text(block, 'baseAddress'), 0)
+            peripheral = Peripheral(ip_text(block, 'name'), base, clean_text(ip_text(block, 'description')))
+            block_access = ip_text(block, 'access')
+            for node in ip_children(block, 'register'):
+                dim = parse_int(ip_text(node, 'dim'))
+                size = parse_int(ip_text(node, 'size'), 32)
+                offset = parse_int(ip_text(node, 'addressOffset'), 0)
+                reg_reset, reg_reset_mask = ip_reset(node)
+                for name, shift in expand_dim(ip_text(node, 'name'), dim, size // 8, None):
+                    reg = Reg(name, base + offset + shift, size, reg_reset, reg_reset_mask, clean_text(ip_text(node, 'description')))
+                    reg_access = ip_text(node, 'access', block_access)
+                    reset, reset_mask, known = 0, 0, reg_reset is not None
+                    for field_node in ip_children(node, 'field'):
+                        lsb = parse_int(ip_text(field_node, 'bitOffset'), 0)
+                        width = parse_int(ip_text(field_node, 'bitWidth'), 1)
+                        field = Field(ip_text(field_node, 'name'), lsb + width - 1, lsb,
+                                      field_access(ip_text(field_node, 'access', reg_access),
+                                                   ip_text(field_node, 'modifiedWriteValue'), ip_text(field_node, 'readAction')),
+                                      clean_text(ip_text(field_node, 'description')))
+                        values = ip_child(field_node, 'enumeratedValues')
+                        if values is not None:
+                            for value in ip_children(values, 'enumeratedValue'):
+                                field.enums.append((ip_text(value, 'name'), parse_int(ip_text(value, 'value')), clean_text(ip_text(value, 'description'))))
+                        field_reset, _ = ip_reset(field_node)
+                        if field_reset is not None:
+                            reset |= (field_reset << lsb) & field.mask()
+                            reset_mask |= field.mask()
+                        reg.fields.append(field)
+                    if not known and reset_mask != 0:
+                        reg.reset, reg.reset_mask = reset, reset_mask
+                    peripheral.registers.append(reg)
+            peripherals.append(peripheral)
+    return peripherals, bus_width
+
+
+# ------------------------------------------------------------------------------------------
+# CSV
+
+def load_csv(path):
+    peripherals = {}
+    registers = {}
+    with open(path, newline='') as stream:
+        for line, row in enumerate(csv.DictReader(stream), start=2):
+            row = {key.strip().lower(): (value or '').strip() for key, value in row.items() if key is not None}
+            name = row.get('peripheral')
+            if not name:
+                continue
+            if name not in peripherals:
+                peripherals[name] = Peripheral(name, parse_int(row.get('base'), 0))
+            peripheral = peripherals[name]
+            key = (name, row['register'])
+            if key not in registers:
+                reg = Reg(row['register'], peripheral.base + parse_int(row.get('offset'), 0), parse_int(row.get('size'), 32),
+                          parse_int(row.get('reset')), None, row.get('description', '') if not row.get('field') else '')
+                registers[key] = reg
+                peripheral.registers.append(reg)
+            reg = registers[key]
+            if row.get('field'):
+                msb = parse_int(row.get('msb'))
+                lsb = parse_int(row.get('lsb'), msb)
+                if msb is None:
+                    raise GeneratorError('{}:{}: field {} has no msb'.format(path, line, row['field']))
+                access = row.get('access', '').upper()
+                if access not in ('RW', 'RO', 'WO', 'W1C', 'W1S', 'RC'):
+                    access = field_access(row.get('access'), None, None)
+                reg.fields.append(Field(row['field'], msb, lsb, access, row.get('description', '')))
+    return list(peripherals.values()), 32
+
+
+# ------------------------------------------------------------------------------------------
+# Header emitter
+
+CPP_KEYWORDS = set('''alignas alignof and and_eq asm auto bitand bitor bool break case catch char char8_t char16_t char32_t class
+    compl concept const consteval constexpr constinit const_cast continue co_await co_return co_yield decltype default delete do
+    double dynamic_cast else enum explicit export extern false float for friend goto if inline int long mutable namespace new
+    noexcept not not_eq nullptr operator or or_eq private protected public register reinterpret_cast requires return short signed
+    sizeof static static_assert static_cast struct switch template this thread_local throw true try typedef typeid typename union
+    unsigned using virtual void volatile wchar_t while xor xor_eq'''.split())
+
+# Names, declared by Register::Description
+DESCRIPTION_NAMES = {'Io', 'IoDescription', 'RegisterValueType', 'HardwareUpdated', 'Value', 'Reserved', 'ResetValue', 'FieldDefaults',
+                     'WriteOneFields', 'RW', 'RO', 'WO', 'RS', 'W1C', 'W1S', 'RC', 'SC', 'getAddress', 'Description', 'Type'}
+
+NAMESPACE_NAMES = {'Description', 'Register'}
+
+
+def identifier(name, camel, prefix):
+    parts = [part for part in re.split(r'[^0-9A-Za-z]+', name or '') if part]
+    if camel:
+        text = ''.join((part.capitalize() if (part.upper() == part) else part[0].upper() + part[1:]) for part in parts)
+    else:
+        text = '_'.join(parts)
+    if text == '' or text[0].isdigit():
+        text = prefix + text
+    if text in CPP_KEYWORDS:
+        text = text + '_'
+    return text
+
+
+def unique(name, used, suffix):
+    result = name
+    if result in used:
+        result = name + suffix
+    number = 1
+    while result in used:
+        result = '{}{}{}'.format(name, suffix, number)
+        number += 1
+    used.add(result)
+    return result
+
+
+def hex_value(value, size):
+    return '0x{:0{}X}'.format(value, max(1, size // 4))
+
+
+def value_type(size):
+    return {8: 'uint8_t', 16: 'uint16_t', 32: 'uint32_t', 64: 'uint64_t'}[size]
+
+
+class Emitter:
+    INDENT = '        '
+
+    def __init__(self, args, bus_width, source):
+        self.args = args
+        self.bus_width = bus_width
+        self.source = source
+        self.errors = []
+        self.warnings = []
+
+    def problem(self, text):
+        if self.args.keep_going:
+            self.warnings.append(text)
+            return True
+        self.errors.append(text)
+        return False
+
+    def check_fields(self, peripheral, reg):
+        """ Fields, which fit into register and don't overlap, in msb order """
+        result = []
+        used = 0
+        where = '{}.{}'.format(peripheral.name, reg.name)
+        for field in sorted(reg.fields, key=lambda item: (-item.msb, -item.lsb)):
+            if field.lsb < 0 or field.msb < field.lsb or field.msb >= reg.size:
+                self.problem('{}: field {} [{}:{}] is outside of {} bit register'.format(where, field.name, field.msb, field.lsb, reg.size))
+                continue
+            if used & field.mask():
+                overlapped = [other.name for other in result if other.mask() & field.mask()]
+                self.problem('{}: field {} [{}:{}] overlaps {}'.format(where, field.name, field.msb, field.lsb, ', '.join(overlapped)))
+                continue
+            limit = 1 << (field.msb - field.lsb + 1)
+            enums = []
+            for name, value, description in field.enums:
+                if value is None or value >= limit:
+                    self.problem('{}: value {} = {} of field {} doesn\'t fit {} bits'.format(where, name, value, field.name, field.msb - field.lsb + 1))
+                    continue
+                enums.append((name, value, description))
+            field.enums = enums
+            used |= field.mask()
+            result.append(field)
+        return result
+
+    def comment(self, lines, indent):
+        return [indent + '// ' + line for line in lines if line]
+
+    def field_lines(self, reg, field, names):
+        indent = self.INDENT
+        bits = '[{}]'.format(field.msb) if field.msb == field.lsb else '[{}:{}]'.format(field.msb, field.lsb)
+        lines = self.comment([(bits + ' ' + field.description).strip()], indent)
+        field_type = ''
+        if field.enums:
+            field.enum_name = unique('T' + field.cpp_name, names, 'Type')
+            field.enum_values = {}
+            lines.append(indent + 'enum class {} {{'.format(field.enum_name))
+            enum_names = set()
+            for position, (name, value, description) in enumerate(field.enums):
+                cpp_name = unique(identifier(name, self.args.camel, 'V'), enum_names, 'Value')
+                field.enum_values.setdefault(value, cpp_name)
+                separator = ',' if position + 1 != len(field.enums) else ''
+                text = indent * 2 + '{} = {}{}'.format(cpp_name, value, separator)
+                if description:
+                    text += ' // ' + description
+                lines.append(text)
+            lines.append(indent + '};')
+            field_type = ', ' + field.enum_name
+        if field.msb == field.lsb:
+            descr = 'Bit< {}{} >'.format(field.msb, field_type)
+        else:
+            descr = 'Field< {}, {}{} >'.format(field.msb, field.lsb, field_type)
+        if field.access in ('W1C', 'W1S'):
+            # set() of write-one field keeps RW bits of register, so it needs register type
+            descr += ', ' + reg.cpp_name
+        lines.append(indent + 'typedef {}< getAddress(), {} > {};'.format(field.access, descr, field.cpp_name))
+        return lines
+
+    def default_value(self, field, value):
+        if field.enums:
+            if value in field.enum_values:
+                return '{}::{}'.format(field.enum_name, field.enum_values[value])
+            return 'static_cast< {} >( {} )'.format(field.enum_name, value)
+        return '{}u'.format(hex_value(value, 4)) if value < (1 << 32) else '{}ull'.format(hex_value(value, 4))
+
+    def register_lines(self, peripheral, reg, names):
+        indent = self.INDENT
+        reg.cpp_name = unique(identifier(reg.name, self.args.camel, 'R'), names, 'Reg')
+        fields = self.check_fields(peripheral, reg)
+        lines = self.comment([reg.description], '')
+        template = hex_value(reg.address, self.args.address_bits)
+        if reg.size != 32:
+            template += ', ' + value_type(reg.size)
+            if reg.size == 64 and self.bus_width >= 64:
+                template += ', Mem64IoDescription'
+        lines.append('struct {} : public Description< {} > {{'.format(reg.cpp_name, template))
+        member_names = set(DESCRIPTION_NAMES)
+        for field in fields:
+            field.cpp_name = unique(identifier(field.name, self.args.camel, 'F'), member_names, 'Field')
+        if fields and not any(field.access in ('RW', 'WO', 'W1C', 'W1S') for field in fields):
+            lines.append(indent + '// Status register, it is updated by hardware')
+            lines.append(indent + 'static constexpr const bool HardwareUpdated = true;')
+            lines.append('')
+        for field in fields:
+            lines += self.field_lines(reg, field, member_names)
+            lines.append('')
+
+        fields_mask = 0
+        for field in fields:
+            fields_mask |= field.mask()
+        reserved = reg.full_mask() & ~fields_mask if fields else 0
+        if reserved:
+            lines.append(indent + '// Reserved bits')
+            lines.append(indent + 'typedef RS< getAddress(), BitMask< {} > > Reserved;'.format(hex_value(reserved, reg.size)))
+        else:
+            lines.append(indent + 'typedef RS< getAddress() > Reserved;')
+
+        write_one = [field.cpp_name for field in fields if field.access in ('W1C', 'W1S')]
+        if write_one:
+            lines.append(indent + 'typedef FieldSet< {} > WriteOneFields;'.format(', '.join(write_one)))
+        read_only = [field.cpp_name for field in fields if field.access in ('RO', 'RC')]
+        if read_only:
+            lines.append(indent + 'typedef FieldSet< {} > ReadOnlyFields;'.format(', '.join(read_only)))
+
+        if reg.reset is not None:
+            reset_mask = reg.full_mask() if reg.reset_mask is None else reg.reset_mask & reg.full_mask()
+            known = fields_mask if fields else reg.full_mask()
+            if (reset_mask & known) == known:
+                lines.append(indent + 'static constexpr const {} ResetValue = {};'.format(value_type(reg.size), hex_value(reg.reset & reg.full_mask(), reg.size)))
+            else:
+                defaults = ['Default< {}, {} >'.format(field.cpp_name, self.default_value(field, (reg.reset & field.mask()) >> field.lsb))
+                            for field in fields if (reset_mask & field.mask()) == field.mask()]
+                if defaults:
+                    lines.append(indent + 'typedef Defaults< {} > FieldDefaults;'.format(', '.join(defaults)))
+        lines.append('};')
+        lines.append('')
+        return lines
+
+    def header(self, peripheral):
+        namespace = identifier(peripheral.name, True, 'P')
+        if namespace in NAMESPACE_NAMES or namespace in CPP_KEYWORDS:
+            namespace += 'Regs'
+        macro = re.sub(r'[^0-9A-Z]+', '_', re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', namespace).upper()) + '_IO'
+        lines = [
+            '',
+            '#pragma once',
+            '',
+            '/* Generated by tools/regmapgen.py from {}, please don\'t edit */'.format(os.path.basename(self.source)),
+            '',
+            '#include <stddef.h>',
+            '#include <stdint.h>',
+            '#include <RegistersClass.h>',
+            '',
+            '/*',
+            '        Register access backend of {} block ( base {} ).'.format(peripheral.name, hex_value(peripheral.base, self.args.address_bits)),
+            '        Define it before include of this header to use another backend ( see MemIoLinux.h ).',
+            '*/',
+            '#ifndef {}'.format(macro),
+            '#define {} Register::DirectIo'.format(macro),
+            '#endif',
+            '',
+            'namespace {} {{'.format(namespace),
+            '',
+            'using namespace Register;',
+            '',
+            'template<AddressType address, typename RegValueType = DefaultValueType, typename IoDescription = MemIoDescription<RegValueType> >',
+            'using Description = Register::Description< address, RegValueType, {}, IoDescription >;'.format(macro),
+            '',
+        ]
+        lines += self.comment([peripheral.description], '')
+        if peripheral.description:
+            lines.append('')
+        names = set(NAMESPACE_NAMES) | {namespace}
+        for reg in sorted(peripheral.registers, key=lambda item: item.address):
+            lines += self.register_lines(peripheral, reg, names)
+        lines.append('}} // {}'.format(namespace))
+        lines.append('')
+        return lines
+
+    def file_name(self, peripheral):
+        name = re.sub(r'([a-z0-9])([A-Z])', r'\1_\2', identifier(peripheral.name, True, 'P'))
+        return '{}{}_regs.h'.format(self.args.prefix, name.lower())
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate RegistersClass.h register descriptions, one header per peripheral')
+    parser.add_argument('input', help='CMSIS-SVD, IP-XACT or CSV file')
+    parser.add_argument('-o', '--output', default='.', help='output directory')
+    parser.add_argument('-f', '--format', choices=('auto', 'svd', 'ipxact', 'csv'), default='auto')
+    parser.add_argument('-p', '--peripheral', action='append', help='generate only given peripheral (may be repeated)')
+    parser.add_argument('--prefix', default='', help='prefix of header file names, i.e. "hi3516ev200_"')
+    parser.add_argument('--address-bits', type=int, default=32, help='digits of addresses in headers')
+    parser.add_argument('--keep-names', dest='camel', action='store_false', help='keep names of source file, don\'t convert them to CamelCase')
+    parser.add_argument('--keep-going', action='store_true', help='report errors as warnings, drop wrong fields and values')
+    args = parser.parse_args()
+
+    input_format = args.format
+    if input_format == 'auto':
+        if args.input.lower().endswith('.csv'):
+            input_format = 'csv'
+        else:
+            root = next(ElementTree.iterparse(args.input, events=('start',)))[1]
+            input_format = 'svd' if local(root.tag) == 'device' else 'ipxact'
+    try:
+        loader = {'svd': load_svd, 'ipxact': load_ipxact, 'csv': load_csv}[input_format]
+        peripherals, bus_width = loader(args.input)
+    except (GeneratorError, ValueError, ElementTree.ParseError) as error:
+        print('regmapgen: {}'.format(error), file=sys.stderr)
+        return 1
+
+    if args.peripheral:
+        wanted = set(args.peripheral)
+        peripherals = [peripheral for peripheral in peripherals if peripheral.name in wanted or identifier(peripheral.name, True, 'P') in wanted]
+
+    emitter = Emitter(args, bus_width, args.input)
+    headers = {}
+    for peripheral in peripherals:
+        name = emitter.file_name(peripheral)
+        if name in headers:
+            emitter.problem('peripherals {} and {} have the same header {}'.format(headers[name][0], peripheral.name, name))
+            continue
+        headers[name] = (peripheral.name, emitter.header(peripheral))
+
+    for text in emitter.warnings:
+        print('regmapgen: warning: {}'.format(text), file=sys.stderr)
+    if emitter.errors:
+        for text in emitter.errors:
+            print('regmapgen: error: {}'.format(text), file=sys.stderr)
+        return 1
+
+    os.makedirs(args.output, exist_ok=True)
+    for name, (_, lines) in headers.items():
+        path = os.path.join(args.output, name)
+        text = '\n'.join(lines)
+        # Unchanged headers are not rewritten, so build doesn't recompile their users
+        if os.path.exists(path):
+            with open(path) as stream:
+                if stream.read() == text:
+                    continue
+        with open(path, 'w') as stream:
+            stream.write(text)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())